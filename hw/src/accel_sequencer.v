@@ -0,0 +1,195 @@
+`timescale 1ns / 1ps
+
+// Micro-sequencer that runs small programs from the wrapper's instruction
+// memory and drives the tile engine, so whole layer loops execute without
+// the CPU. Instruction format:
+//   [31:28] opcode  [25:24] register select  [15:0] immediate
+//
+//   END              stop, pulse done
+//   SETA  ra, imm    ra = imm                  (address registers a0-a3)
+//   ADDA  ra, imm    ra = ra + sext(imm)
+//   LDA   ra, ld     load A tile from ra, row stride ld
+//   LDB   ra, ld     load B tile from ra, row stride ld
+//   GEMM             C = A * B
+//   GEMMA            C = C + A * B
+//   ELT   fn         element-wise op on C (tile_engine ELTWISE argument)
+//   STC   ra, ld     store C tile to ra, row stride ld
+//   SETC  rc, imm    rc = imm                  (loop counters c0-c3)
+//   LOOP  rc, pc     rc = rc - 1, jump to pc while rc != 0
+//   WAIT             block until the CPU rings the signal doorbell
+//   LDAZ  ra         load A from a zero-run-length stream at ra
+//   STCZ  ra, sh     store C >> sh as int8 zero-run-length stream at ra
+// Undefined opcodes stop the program like END.
+module accel_sequencer #(
+    parameter IMEM_ADDR_WIDTH = 6
+)(
+    input clk,
+    input rst_n,
+
+    input                       start,
+    input [IMEM_ADDR_WIDTH-1:0] start_pc,
+    input                       signal,  // Doorbell pulse from the CPU
+    output                      busy,
+    output reg                  done,
+    output [IMEM_ADDR_WIDTH-1:0] pc_out,
+
+    // Instruction memory read port (combinational read)
+    output [IMEM_ADDR_WIDTH-1:0] imem_addr,
+    input  [31:0]                imem_rdata,
+
+    // Tile engine operation interface
+    output reg        op_valid,
+    output reg [2:0]  op_code,
+    output     [31:0] op_addr,
+    output     [15:0] op_arg,
+    input             op_ready,
+    input             op_done
+);
+
+    // Opcodes
+    localparam SEQ_END   = 4'd0;
+    localparam SEQ_SETA  = 4'd1;
+    localparam SEQ_ADDA  = 4'd2;
+    localparam SEQ_LDA   = 4'd3;
+    localparam SEQ_LDB   = 4'd4;
+    localparam SEQ_GEMM  = 4'd5;
+    localparam SEQ_GEMMA = 4'd6;
+    localparam SEQ_ELT   = 4'd7;
+    localparam SEQ_STC   = 4'd8;
+    localparam SEQ_SETC  = 4'd9;
+    localparam SEQ_LOOP  = 4'd10;
+    localparam SEQ_WAIT  = 4'd11;
+    localparam SEQ_LDAZ  = 4'd12;
+    localparam SEQ_STCZ  = 4'd13;
+
+    // Tile engine operations
+    localparam TILE_LOAD_A  = 3'd0;
+    localparam TILE_LOAD_B  = 3'd1;
+    localparam TILE_GEMM    = 3'd2;
+    localparam TILE_STORE_C = 3'd3;
+    localparam TILE_ELTWISE = 3'd4;
+    localparam TILE_LOAD_A_RLE  = 3'd5;
+    localparam TILE_STORE_C_RLE = 3'd6;
+
+    // FSM states
+    localparam IDLE    = 2'd0;
+    localparam RUN     = 2'd1;
+    localparam WAIT_OP = 2'd2;
+
+    reg [1:0] state;
+    reg [IMEM_ADDR_WIDTH-1:0] pc;
+    reg [31:0] areg [0:3];
+    reg [15:0] creg [0:3];
+    reg [7:0]  signal_count;
+
+    wire [3:0]  opcode = imem_rdata[31:28];
+    wire [1:0]  rsel   = imem_rdata[25:24];
+    wire [15:0] imm    = imem_rdata[15:0];
+
+    // WAIT consumes one doorbell, either pending or arriving this cycle
+    wire wait_take = (state == RUN) && (opcode == SEQ_WAIT) && (signal_count != 0 || signal);
+
+    assign imem_addr = pc;
+    assign pc_out    = pc;
+    assign busy      = (state != IDLE);
+
+    assign op_addr = areg[rsel];
+    assign op_arg  = (opcode == SEQ_GEMMA) ? 16'd1 :
+                     (opcode == SEQ_GEMM)  ? 16'd0 : imm;
+
+    always @(*) begin
+        op_valid = 1'b0;
+        op_code  = TILE_LOAD_A;
+        if (state == RUN) begin
+            case (opcode)
+                SEQ_LDA:   begin op_valid = 1'b1; op_code = TILE_LOAD_A;  end
+                SEQ_LDB:   begin op_valid = 1'b1; op_code = TILE_LOAD_B;  end
+                SEQ_GEMM,
+                SEQ_GEMMA: begin op_valid = 1'b1; op_code = TILE_GEMM;    end
+                SEQ_ELT:   begin op_valid = 1'b1; op_code = TILE_ELTWISE; end
+                SEQ_STC:   begin op_valid = 1'b1; op_code = TILE_STORE_C; end
+                SEQ_LDAZ:  begin op_valid = 1'b1; op_code = TILE_LOAD_A_RLE;  end
+                SEQ_STCZ:  begin op_valid = 1'b1; op_code = TILE_STORE_C_RLE; end
+                default:   ;
+            endcase
+        end
+    end
+
+    integer n;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            state <= IDLE;
+            pc <= 0;
+            done <= 0;
+            signal_count <= 0;
+            for (n = 0; n < 4; n = n + 1) begin
+                areg[n] <= 0;
+                creg[n] <= 0;
+            end
+        end else begin
+            done <= 0;
+
+            // Doorbells may arrive before the program reaches its WAIT
+            if (signal && !wait_take) begin
+                if (signal_count != 8'hFF) signal_count <= signal_count + 1;
+            end else if (!signal && wait_take) begin
+                signal_count <= signal_count - 1;
+            end
+
+            case (state)
+                IDLE: begin
+                    if (start) begin
+                        pc <= start_pc;
+                        state <= RUN;
+                    end
+                end
+                RUN: begin
+                    case (opcode)
+                        SEQ_SETA: begin
+                            areg[rsel] <= {16'h0, imm};
+                            pc <= pc + 1;
+                        end
+                        SEQ_ADDA: begin
+                            areg[rsel] <= areg[rsel] + {{16{imm[15]}}, imm};
+                            pc <= pc + 1;
+                        end
+                        SEQ_LDA, SEQ_LDB, SEQ_GEMM, SEQ_GEMMA, SEQ_ELT, SEQ_STC,
+                        SEQ_LDAZ, SEQ_STCZ: begin
+                            if (op_ready) state <= WAIT_OP;
+                        end
+                        SEQ_SETC: begin
+                            creg[rsel] <= imm;
+                            pc <= pc + 1;
+                        end
+                        SEQ_LOOP: begin
+                            if (creg[rsel] > 1) begin
+                                creg[rsel] <= creg[rsel] - 1;
+                                pc <= imm[IMEM_ADDR_WIDTH-1:0];
+                            end else begin
+                                creg[rsel] <= 0;
+                                pc <= pc + 1;
+                            end
+                        end
+                        SEQ_WAIT: begin
+                            if (wait_take) pc <= pc + 1;
+                        end
+                        default: begin
+                            // END and undefined opcodes
+                            done <= 1;
+                            state <= IDLE;
+                        end
+                    endcase
+                end
+                WAIT_OP: begin
+                    if (op_done) begin
+                        pc <= pc + 1;
+                        state <= RUN;
+                    end
+                end
+                default:
+                    state <= IDLE;
+            endcase
+        end
+    end
+
+endmodule
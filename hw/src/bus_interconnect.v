@@ -6,7 +6,12 @@ module bus_interconnect #(
     parameter RAM_BASE = 32'h00010000,
     parameter RAM_TOP  = 32'h00013FFF,
     parameter ACCEL_BASE = 32'h10000000,
-    parameter ACCEL_TOP  = 32'h100003FF
+    parameter ACCEL_TOP  = 32'h10001FFF,
+    parameter NUM_ACCEL  = 1,             // Accelerator units, one window each
+    parameter ACCEL_SPAN = 32'h00002000,  // Address window per unit
+    parameter ACCEL_BCAST_BASE = 32'h10100000, // Broadcast window, mask register after it
+    parameter RAM_BANKS = 4,
+    parameter RAM_STATS_BASE = 32'h10200000   // Per-bank RAM conflict counters
 )(
     input clk,
     input rst_n,
@@ -25,9 +30,20 @@ module bus_interconnect #(
     wire sel_rom   = (cpu_mem_addr >= ROM_BASE)   && (cpu_mem_addr <= ROM_TOP);
     wire sel_ram   = (cpu_mem_addr >= RAM_BASE)   && (cpu_mem_addr <= RAM_TOP);
     wire sel_accel = (cpu_mem_addr >= ACCEL_BASE) && (cpu_mem_addr <= ACCEL_TOP);
+
+    // Broadcast window: mirrors one unit's register map. Stores are delivered
+    // to every unit enabled in bcast_mask, loads are served by the lowest
+    // enabled unit.
+    wire sel_bcast      = (cpu_mem_addr >= ACCEL_BCAST_BASE) &&
+                          (cpu_mem_addr <  ACCEL_BCAST_BASE + ACCEL_SPAN);
+    wire sel_bcast_mask = (cpu_mem_addr == ACCEL_BCAST_BASE + ACCEL_SPAN);
+
+    // RAM bank conflict counters: word n reads bank n, any write clears all
+    wire sel_ram_stats  = (cpu_mem_addr >= RAM_STATS_BASE) &&
+                          (cpu_mem_addr <  RAM_STATS_BASE + RAM_BANKS*4);
     
     // Invalid address detection
-    wire sel_valid = sel_rom | sel_ram | sel_accel;
+    wire sel_valid = sel_rom | sel_ram | sel_accel | sel_bcast | sel_bcast_mask | sel_ram_stats;
     
     // ROM interface
     wire        rom_mem_valid;
@@ -38,29 +54,101 @@ module bus_interconnect #(
     wire        ram_mem_valid;
     wire        ram_mem_ready;
     wire [31:0] ram_mem_rdata;
+    wire [RAM_BANKS*32-1:0] ram_conflicts;
+    wire [31:0] ram_stats_offset = cpu_mem_addr - RAM_STATS_BASE;
+    wire [31:0] ram_stats_rdata = ram_conflicts[ram_stats_offset[31:2]*32 +: 32];
     
-    // Accelerator interface
+    // Accelerator interface (OR of the per-unit responses; an unselected
+    // unit drives zero read data and is never ready)
     wire        accel_mem_valid;
-    wire        accel_mem_ready;
-    wire [31:0] accel_mem_rdata;
+    reg         accel_mem_ready;
+    reg  [31:0] accel_mem_rdata;
+    wire [NUM_ACCEL-1:0] unit_mem_ready;
+    wire [NUM_ACCEL*32-1:0] unit_mem_rdata;
+
+    // Unit-to-unit chain links: link n feeds unit n, unit n drives link n+1.
+    // Nothing feeds the first unit and results leaving the last are dropped.
+    wire [NUM_ACCEL:0]   chain_valid;
+    wire [NUM_ACCEL*8+7:0] chain_data;
+    wire [NUM_ACCEL:0]   chain_ready;
+
+    assign chain_valid[0] = 1'b0;
+    assign chain_data[7:0] = 8'h0;
+    assign chain_ready[NUM_ACCEL] = 1'b1;
+
+    // Accelerator RAM port: units share the second RAM port, lowest unit
+    // first; the others wait
+    wire [NUM_ACCEL-1:0]    unit_ram_valid;
+    wire [NUM_ACCEL*32-1:0] unit_ram_addr;
+    wire [NUM_ACCEL*32-1:0] unit_ram_wdata;
+    wire [NUM_ACCEL*4-1:0]  unit_ram_wstrb;
+    wire [NUM_ACCEL-1:0]    unit_ram_grant = unit_ram_valid & ~(unit_ram_valid - 1'b1);
+    reg  [31:0]             acc_ram_addr;
+    reg  [31:0]             acc_ram_wdata;
+    reg  [3:0]              acc_ram_wstrb;
+    wire                    acc_ram_ready;
+    wire [31:0]             acc_ram_rdata;
+
+    integer g;
+    always @(*) begin
+        acc_ram_addr = 32'h0;
+        acc_ram_wdata = 32'h0;
+        acc_ram_wstrb = 4'h0;
+        for (g = 0; g < NUM_ACCEL; g = g + 1) begin
+            if (unit_ram_grant[g]) begin
+                acc_ram_addr = unit_ram_addr[g*32 +: 32];
+                acc_ram_wdata = unit_ram_wdata[g*32 +: 32];
+                acc_ram_wstrb = unit_ram_wstrb[g*4 +: 4];
+            end
+        end
+    end
+
+    // Broadcast target mask, all units after reset
+    reg  [NUM_ACCEL-1:0] bcast_mask;
+    wire [NUM_ACCEL-1:0] bcast_read_unit = bcast_mask & ~(bcast_mask - 1'b1);
+    wire [31:0]          bcast_offset = cpu_mem_addr - ACCEL_BCAST_BASE;
+    wire                 bcast_write = sel_bcast && (|cpu_mem_wstrb);
+
+    always @(posedge clk) begin
+        if (!rst_n) begin
+            bcast_mask <= {NUM_ACCEL{1'b1}};
+        end else if (cpu_mem_valid && sel_bcast_mask && cpu_mem_wstrb[0]) begin
+            bcast_mask <= cpu_mem_wdata[NUM_ACCEL-1:0];
+        end
+    end
+
+    integer u;
+    always @(*) begin
+        accel_mem_ready = 1'b0;
+        accel_mem_rdata = 32'h0;
+        for (u = 0; u < NUM_ACCEL; u = u + 1) begin
+            accel_mem_ready = accel_mem_ready | unit_mem_ready[u];
+            accel_mem_rdata = accel_mem_rdata | unit_mem_rdata[u*32 +: 32];
+        end
+    end
 
     // Route valid signal
     assign rom_mem_valid   = cpu_mem_valid & sel_rom;
     assign ram_mem_valid   = cpu_mem_valid & sel_ram;
-    assign accel_mem_valid = cpu_mem_valid & sel_accel;
+    assign accel_mem_valid = cpu_mem_valid & (sel_accel | sel_bcast);
 
     // Multiplex ready signal
     assign cpu_mem_ready = sel_valid ? (
         (sel_rom   ? rom_mem_ready   : 1'b0) |
         (sel_ram   ? ram_mem_ready   : 1'b0) |
-        (sel_accel ? accel_mem_ready : 1'b0)
+        (sel_accel ? accel_mem_ready : 1'b0) |
+        (sel_bcast ? cpu_mem_valid : 1'b0) |   // Units answer in the same cycle
+        (sel_bcast_mask ? cpu_mem_valid : 1'b0) |
+        (sel_ram_stats  ? cpu_mem_valid : 1'b0)
     ) : 1'b0;  // Invalid address returns not ready
 
     // Multiplex read data
     assign cpu_mem_rdata = 
         sel_rom   ? rom_mem_rdata   :
         sel_ram   ? ram_mem_rdata   :
-        sel_accel ? accel_mem_rdata :
+        (sel_accel | sel_bcast) ? accel_mem_rdata :
+        sel_bcast_mask ? {{(32-NUM_ACCEL){1'b0}}, bcast_mask} :
+        sel_ram_stats  ? ram_stats_rdata :
         32'hDEADBEEF;  // Invalid address pattern
 
     // ROM instance (read-only)
@@ -81,7 +169,8 @@ module bus_interconnect #(
     // RAM instance (read-write)
     ram_memory #(
         .SIZE_BYTES(RAM_TOP - RAM_BASE + 1),
-        .BASE_ADDR(RAM_BASE)
+        .BASE_ADDR(RAM_BASE),
+        .NUM_BANKS(RAM_BANKS)
     ) ram (
         .clk(clk),
         .rst_n(rst_n),
@@ -90,26 +179,60 @@ module bus_interconnect #(
         .mem_addr(cpu_mem_addr),
         .mem_wdata(cpu_mem_wdata),
         .mem_wstrb(cpu_mem_wstrb),
-        .mem_rdata(ram_mem_rdata)
+        .mem_rdata(ram_mem_rdata),
+        .acc_mem_valid(|unit_ram_valid),
+        .acc_mem_ready(acc_ram_ready),
+        .acc_mem_addr(acc_ram_addr),
+        .acc_mem_wdata(acc_ram_wdata),
+        .acc_mem_wstrb(acc_ram_wstrb),
+        .acc_mem_rdata(acc_ram_rdata),
+        .clear_conflicts(cpu_mem_valid && sel_ram_stats && (|cpu_mem_wstrb)),
+        .conflict_counts(ram_conflicts)
     );
 
-    // Matrix accelerator wrapper
-    matrix_accel_wrapper #(
-        .DATA_WIDTH(8),
-        .ACC_WIDTH(32),
-        .M(4),
-        .N(4),
-        .P(4),
-        .BASE_ADDR(ACCEL_BASE)
-    ) matrix_accel (
-        .clk(clk),
-        .rst_n(rst_n),
-        .mem_valid(accel_mem_valid),
-        .mem_ready(accel_mem_ready),
-        .mem_addr(cpu_mem_addr),
-        .mem_wdata(cpu_mem_wdata),
-        .mem_wstrb(cpu_mem_wstrb),
-        .mem_rdata(accel_mem_rdata)
-    );
+    // Matrix accelerator units at ACCEL_BASE + n*ACCEL_SPAN
+    genvar n;
+    generate
+        for (n = 0; n < NUM_ACCEL; n = n + 1) begin : accel_unit
+            wire unit_direct = (cpu_mem_addr >= ACCEL_BASE + n*ACCEL_SPAN) &&
+                               (cpu_mem_addr <  ACCEL_BASE + (n+1)*ACCEL_SPAN);
+            wire unit_bcast  = sel_bcast && (bcast_write ? bcast_mask[n] : bcast_read_unit[n]);
+            wire unit_sel    = unit_direct || unit_bcast;
+
+            // Broadcast accesses are rebased into this unit's own window
+            wire [31:0] unit_addr = unit_bcast ? (ACCEL_BASE + n*ACCEL_SPAN + bcast_offset)
+                                               : cpu_mem_addr;
+
+            matrix_accel_wrapper #(
+                .DATA_WIDTH(8),
+                .ACC_WIDTH(32),
+                .M(4),
+                .N(4),
+                .P(4),
+                .BASE_ADDR(ACCEL_BASE + n*ACCEL_SPAN)
+            ) matrix_accel (
+                .clk(clk),
+                .rst_n(rst_n),
+                .mem_valid(accel_mem_valid & unit_sel),
+                .mem_ready(unit_mem_ready[n]),
+                .mem_addr(unit_addr),
+                .mem_wdata(cpu_mem_wdata),
+                .mem_wstrb(cpu_mem_wstrb),
+                .mem_rdata(unit_mem_rdata[n*32 +: 32]),
+                .chain_out_valid(chain_valid[n+1]),
+                .chain_out_data(chain_data[(n+1)*8 +: 8]),
+                .chain_out_ready(chain_ready[n+1]),
+                .chain_in_valid(chain_valid[n]),
+                .chain_in_data(chain_data[n*8 +: 8]),
+                .chain_in_ready(chain_ready[n]),
+                .ram_valid(unit_ram_valid[n]),
+                .ram_ready(unit_ram_grant[n] & acc_ram_ready),
+                .ram_addr(unit_ram_addr[n*32 +: 32]),
+                .ram_wdata(unit_ram_wdata[n*32 +: 32]),
+                .ram_wstrb(unit_ram_wstrb[n*4 +: 4]),
+                .ram_rdata(acc_ram_rdata)
+            );
+        end
+    endgenerate
 
 endmodule 
\ No newline at end of file
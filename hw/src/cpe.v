@@ -0,0 +1,54 @@
+`timescale 1ns / 1ps
+
+// Complex processing element: d = a * b + c on (re, im) pairs, using four
+// real multipliers. With zero imaginary inputs it matches pe.
+module cpe #(
+    parameter DATA_WIDTH = 8,
+    parameter ACC_WIDTH = 32
+) (
+    input clk,
+    input rst_n,
+
+    input signed [DATA_WIDTH-1:0] in_ar,
+    input signed [DATA_WIDTH-1:0] in_ai,
+    input signed [DATA_WIDTH-1:0] in_br,
+    input signed [DATA_WIDTH-1:0] in_bi,
+    input signed [ACC_WIDTH-1:0]  in_cr,
+    input signed [ACC_WIDTH-1:0]  in_ci,
+    input                         in_valid,
+
+    output signed [ACC_WIDTH-1:0] out_dr,
+    output signed [ACC_WIDTH-1:0] out_di,
+    output                        out_valid
+);
+
+    reg signed [ACC_WIDTH-1:0] dr_reg;
+    reg signed [ACC_WIDTH-1:0] di_reg;
+    reg                        valid_reg;
+
+    wire signed [2*DATA_WIDTH-1:0] rr = in_ar * in_br;
+    wire signed [2*DATA_WIDTH-1:0] ii = in_ai * in_bi;
+    wire signed [2*DATA_WIDTH-1:0] ri = in_ar * in_bi;
+    wire signed [2*DATA_WIDTH-1:0] ir = in_ai * in_br;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            dr_reg <= 0;
+            di_reg <= 0;
+            valid_reg <= 0;
+        end else begin
+            if (in_valid) begin
+                dr_reg <= in_cr + rr - ii;
+                di_reg <= in_ci + ri + ir;
+                valid_reg <= 1'b1;
+            end else begin
+                valid_reg <= 1'b0;
+            end
+        end
+    end
+
+    assign out_dr = dr_reg;
+    assign out_di = di_reg;
+    assign out_valid = valid_reg;
+
+endmodule
@@ -6,7 +6,10 @@ module matrix_accel_wrapper #(
     parameter M = 4,
     parameter N = 4,
     parameter P = 4,
-    parameter BASE_ADDR = 32'h10000000
+    parameter BASE_ADDR = 32'h10000000,
+    parameter SCRATCH_BYTES = 4096,
+    parameter CHAIN_DEPTH = 2*M*P,   // Result-forwarding FIFO entries
+    parameter B_CACHE_ENTRIES = 4    // Resident B tiles (at least 2)
 )(
     input clk,
     input rst_n,
@@ -17,16 +20,131 @@ module matrix_accel_wrapper #(
     input  [31:0] mem_addr,
     input  [31:0] mem_wdata,
     input  [3:0]  mem_wstrb,
-    output [31:0] mem_rdata
+    output [31:0] mem_rdata,
+
+    // Result forwarding to the next unit (C elements, requantized)
+    output                  chain_out_valid,
+    output [DATA_WIDTH-1:0] chain_out_data,
+    input                   chain_out_ready,
+
+    // Operand forwarding from the previous unit (A elements, row-major)
+    input                   chain_in_valid,
+    input  [DATA_WIDTH-1:0] chain_in_data,
+    output                  chain_in_ready,
+
+    // RAM master port for in-place operand access
+    output        ram_valid,
+    input         ram_ready,
+    output [31:0] ram_addr,
+    output [31:0] ram_wdata,
+    output [3:0]  ram_wstrb,
+    input  [31:0] ram_rdata
 );
 
     // Memory map offsets  
     localparam CONTROL_REG = 32'h00000100;  // 0x10000100 - Control register
     localparam STATUS_REG  = 32'h00000104;  // 0x10000104 - Status register  
     localparam CONFIG_REG  = 32'h00000108;  // 0x10000108 - Config register
+    localparam JOB_COUNT_REG = 32'h0000010C; // 0x1000010C - Completed job counter
     localparam MATRIX_A_BASE = 32'h00000000; // 0x10000000 - Matrix A data
     localparam MATRIX_B_BASE = 32'h00000040; // 0x10000040 - Matrix B data  
     localparam MATRIX_C_BASE = 32'h00000080; // 0x10000080 - Result matrix
+    localparam ATTN_V_BASE   = 32'h000000C0; // 0x100000C0 - Attention V tile (column-major, like B)
+    localparam BATCH_DESC_BASE = 32'h00000110; // 0x10000110 - Batch descriptor (7 words)
+    localparam SEQ_ENTRY_REG = 32'h0000012C; // 0x1000012C - Sequencer entry PC
+    localparam SEQ_SIGNAL_REG = 32'h00000130; // 0x10000130 - Sequencer doorbell (write)
+    localparam SEQ_PC_REG    = 32'h00000134; // 0x10000134 - Sequencer current PC
+    localparam CHAIN_CTRL_REG = 32'h00000138; // 0x10000138 - Unit chaining control
+    localparam B_GEN_REG     = 32'h0000013C; // 0x1000013C - B tile cache generation
+    localparam B_HITS_REG    = 32'h00000170; // 0x10000170 - B tile cache hits
+    localparam B_MISSES_REG  = 32'h00000174; // 0x10000174 - B tile cache misses
+    localparam RLE_LEN_REG   = 32'h00000178; // 0x10000178 - Last compressed store length (read)
+    localparam RAM_DESC_BASE = 32'h00000180; // 0x10000180 - In-place operand descriptor (6 words)
+    localparam CRC_JOB_REG   = 32'h00000198; // 0x10000198 - CRC of the last job's C writes (read)
+    localparam CRC_RUN_REG   = 32'h0000019C; // 0x1000019C - Running CRC of C writes (write clears)
+    localparam SPMV_DESC_BASE = 32'h000001A0; // 0x100001A0 - CSR SpMV descriptor (6 words)
+    localparam GF_POLY_REG   = 32'h000001B8; // 0x100001B8 - GF(2^8) reduction polynomial
+    localparam SOFTMAX_CFG_REG = 32'h000001BC; // 0x100001BC - Softmax logit shift
+    localparam POOL_DESC_BASE = 32'h000001C0; // 0x100001C0 - Pooling descriptor (6 words)
+    localparam NORM_DESC_BASE = 32'h000001D8; // 0x100001D8 - LayerNorm/RMSNorm descriptor (8 words)
+    localparam GEMM_DESC_BASE = 32'h00000140; // 0x10000140 - Large GEMM descriptor (9 words)
+    localparam SEQ_IMEM_BASE = 32'h00000200; // 0x10000200 - Sequencer program (64 words)
+    localparam CPLX_A_BASE   = 32'h00000300; // 0x10000300 - Complex A, {im, re} per word
+    localparam CPLX_B_BASE   = 32'h00000340; // 0x10000340 - Complex B, {im, re} per word
+    localparam CPLX_C_BASE   = 32'h00000380; // 0x10000380 - Complex C, {im, re} saturated to 16 bits (read)
+    localparam C_IMAG_BASE   = 32'h000003C0; // 0x100003C0 - Imaginary part of C (read)
+    localparam SCRATCH_BASE  = 32'h00001000; // 0x10001000 - Operand scratchpad
+
+    // Batch descriptor words
+    localparam BATCH_COUNT    = 0;
+    localparam BATCH_A_BASE   = 1;
+    localparam BATCH_B_BASE   = 2;
+    localparam BATCH_C_BASE   = 3;
+    localparam BATCH_A_STRIDE = 4;
+    localparam BATCH_B_STRIDE = 5;
+    localparam BATCH_C_STRIDE = 6;
+
+    // Large GEMM descriptor words (leading dimensions in bytes)
+    localparam GEMM_M      = 0;
+    localparam GEMM_N      = 1;
+    localparam GEMM_P      = 2;
+    localparam GEMM_A_BASE = 3;
+    localparam GEMM_B_BASE = 4;
+    localparam GEMM_C_BASE = 5;
+    localparam GEMM_LDA    = 6;
+    localparam GEMM_LDB    = 7;
+    localparam GEMM_LDC    = 8;
+
+    // In-place operand descriptor words (RAM byte addresses, strides in bytes)
+    localparam RAM_A_ADDR = 0;
+    localparam RAM_B_ADDR = 1;
+    localparam RAM_C_ADDR = 2;
+    localparam RAM_LDA    = 3;
+    localparam RAM_LDB    = 4;
+    localparam RAM_LDC    = 5;
+
+    // CSR SpMV descriptor words (RAM byte addresses)
+    localparam SPMV_ROWS    = 0;
+    localparam SPMV_ROW_PTR = 1;
+    localparam SPMV_COL_IDX = 2;
+    localparam SPMV_VALUES  = 3;
+    localparam SPMV_X       = 4;
+    localparam SPMV_Y       = 5;
+
+    // Pooling descriptor words (scratchpad byte offsets)
+    localparam POOL_SRC      = 0;
+    localparam POOL_DST      = 1;
+    localparam POOL_HEIGHT   = 2;
+    localparam POOL_WIDTH    = 3;
+    localparam POOL_CHANNELS = 4;
+    localparam POOL_MODE     = 5;   // [3:0] window, [11:8] stride, [16] average
+
+    // Normalization descriptor word indices
+    localparam NORM_SRC     = 0;
+    localparam NORM_DST     = 1;
+    localparam NORM_PARAMS  = 2;
+    localparam NORM_ROWS    = 3;
+    localparam NORM_LEN     = 4;
+    localparam NORM_INV_LEN = 5;
+    localparam NORM_EPS     = 6;
+    localparam NORM_MODE    = 7;   // [0] RMSNorm
+
+    // Tile engine operations
+    localparam TILE_LOAD_A  = 3'd0;
+    localparam TILE_LOAD_B  = 3'd1;
+    localparam TILE_GEMM    = 3'd2;
+    localparam TILE_STORE_C = 3'd3;
+
+    // Fused attention steps
+    localparam ATTN_IDLE    = 2'd0;
+    localparam ATTN_QK      = 2'd1;
+    localparam ATTN_SOFTMAX = 2'd2;
+    localparam ATTN_PV      = 2'd3;
+
+    localparam SCRATCH_WORDS = SCRATCH_BYTES / 4;
+    localparam SPAD_ADDR_WIDTH = $clog2(SCRATCH_WORDS);
+    localparam SEQ_WORDS = 64;
+    localparam SEQ_ADDR_WIDTH = $clog2(SEQ_WORDS);
 
     // Calculate relative address
     wire [31:0] rel_addr = mem_addr - BASE_ADDR;
@@ -35,24 +153,407 @@ module matrix_accel_wrapper #(
     wire access_control = (rel_addr == CONTROL_REG);
     wire access_status  = (rel_addr == STATUS_REG);
     wire access_config  = (rel_addr == CONFIG_REG);
+    wire access_job_count = (rel_addr == JOB_COUNT_REG);
     wire access_matrix_a = (rel_addr >= MATRIX_A_BASE) && (rel_addr < MATRIX_A_BASE + M*N*4);
     wire access_matrix_b = (rel_addr >= MATRIX_B_BASE) && (rel_addr < MATRIX_B_BASE + N*P*4);
+    wire access_attn_v   = (rel_addr >= ATTN_V_BASE) && (rel_addr < ATTN_V_BASE + N*P*4);
     wire access_matrix_c = (rel_addr >= MATRIX_C_BASE) && (rel_addr < MATRIX_C_BASE + M*P*4);
+    wire access_batch_desc = (rel_addr >= BATCH_DESC_BASE) && (rel_addr < BATCH_DESC_BASE + 7*4);
+    wire access_scratch  = (rel_addr >= SCRATCH_BASE) && (rel_addr < SCRATCH_BASE + SCRATCH_BYTES);
+    wire access_seq_entry = (rel_addr == SEQ_ENTRY_REG);
+    wire access_seq_signal = (rel_addr == SEQ_SIGNAL_REG);
+    wire access_seq_pc   = (rel_addr == SEQ_PC_REG);
+    wire access_chain_ctrl = (rel_addr == CHAIN_CTRL_REG);
+    wire access_b_gen    = (rel_addr == B_GEN_REG);
+    wire access_b_hits   = (rel_addr == B_HITS_REG);
+    wire access_b_misses = (rel_addr == B_MISSES_REG);
+    wire access_rle_len  = (rel_addr == RLE_LEN_REG);
+    wire access_crc_job  = (rel_addr == CRC_JOB_REG);
+    wire access_crc_run  = (rel_addr == CRC_RUN_REG);
+    wire access_gf_poly  = (rel_addr == GF_POLY_REG);
+    wire access_softmax_cfg = (rel_addr == SOFTMAX_CFG_REG);
+    wire access_seq_imem = (rel_addr >= SEQ_IMEM_BASE) && (rel_addr < SEQ_IMEM_BASE + SEQ_WORDS*4);
+    wire access_cplx_a   = (rel_addr >= CPLX_A_BASE) && (rel_addr < CPLX_A_BASE + M*N*4);
+    wire access_cplx_b   = (rel_addr >= CPLX_B_BASE) && (rel_addr < CPLX_B_BASE + N*P*4);
+    wire access_cplx_c   = (rel_addr >= CPLX_C_BASE) && (rel_addr < CPLX_C_BASE + M*P*4);
+    wire access_c_imag   = (rel_addr >= C_IMAG_BASE) && (rel_addr < C_IMAG_BASE + M*P*4);
+    wire access_gemm_desc = (rel_addr >= GEMM_DESC_BASE) && (rel_addr < GEMM_DESC_BASE + 9*4);
+    wire access_ram_desc = (rel_addr >= RAM_DESC_BASE) && (rel_addr < RAM_DESC_BASE + 6*4);
+    wire access_spmv_desc = (rel_addr >= SPMV_DESC_BASE) && (rel_addr < SPMV_DESC_BASE + 6*4);
+    wire access_pool_desc = (rel_addr >= POOL_DESC_BASE) && (rel_addr < POOL_DESC_BASE + 6*4);
+    wire access_norm_desc = (rel_addr >= NORM_DESC_BASE) && (rel_addr < NORM_DESC_BASE + 8*4);
+
+    wire [2:0] batch_desc_index = (rel_addr - BATCH_DESC_BASE) >> 2;
+    wire [3:0] gemm_desc_index  = (rel_addr - GEMM_DESC_BASE) >> 2;
+    wire [2:0] ram_desc_index   = (rel_addr - RAM_DESC_BASE) >> 2;
+    wire [2:0] spmv_desc_index  = (rel_addr - SPMV_DESC_BASE) >> 2;
+    wire [2:0] pool_desc_index  = (rel_addr - POOL_DESC_BASE) >> 2;
+    wire [2:0] norm_desc_index  = (rel_addr - NORM_DESC_BASE) >> 2;
+    wire [SPAD_ADDR_WIDTH-1:0] scratch_index = (rel_addr - SCRATCH_BASE) >> 2;
+    wire [SEQ_ADDR_WIDTH-1:0]  seq_imem_index = (rel_addr - SEQ_IMEM_BASE) >> 2;
     
     // Control and status registers
     reg [31:0] control_reg;
     reg [31:0] status_reg;
     reg [31:0] config_reg;
+    reg [15:0] chain_ctrl;
+    reg [7:0]  gf_poly;     // x^8 + gf_poly, 0x1D by default
+    reg [4:0]  softmax_shift;
     
     // Matrix data storage
     reg [DATA_WIDTH-1:0] matrix_a [0:M*N-1];
-    reg [DATA_WIDTH-1:0] matrix_b [0:N*P-1];
+    reg [DATA_WIDTH-1:0] matrix_b [0:B_CACHE_ENTRIES*N*P-1]; // One tile per cache entry
+    reg [DATA_WIDTH-1:0] matrix_v [0:N*P-1];                 // Attention values, B layout
     reg [ACC_WIDTH-1:0]  matrix_c [0:M*P-1];
+
+    // Imaginary parts for complex jobs (CONFIG[26]). The tile engine and
+    // in-place jobs only move real parts; complex operands come through the
+    // CPLX windows, whose B side is column-major like the B window.
+    reg [DATA_WIDTH-1:0] matrix_ai [0:M*N-1];
+    reg [DATA_WIDTH-1:0] matrix_bi [0:N*P-1];
+    reg [ACC_WIDTH-1:0]  matrix_ci [0:M*P-1];
+    wire [$clog2(M*N)-1:0] cplx_a_index = (rel_addr - CPLX_A_BASE) >> 2;
+    wire [$clog2(N*P)-1:0] cplx_b_index = (rel_addr - CPLX_B_BASE) >> 2;
+    wire [$clog2(M*P)-1:0] cplx_c_index = (rel_addr - CPLX_C_BASE) >> 2;
+    wire [$clog2(M*P)-1:0] c_imag_index = (rel_addr - C_IMAG_BASE) >> 2;
+
+    function [15:0] sat16;
+        input signed [ACC_WIDTH-1:0] value;
+        begin
+            if (value > 32767)
+                sat16 = 16'h7FFF;
+            else if (value < -32768)
+                sat16 = 16'h8000;
+            else
+                sat16 = value[15:0];
+        end
+    endfunction
+
+    // Scratchpad holding packed operand tiles (4 elements per word) and
+    // 32-bit result tiles for hardware-sequenced jobs
+    reg [31:0] scratch [0:SCRATCH_WORDS-1];
+    reg [31:0] batch_desc [0:6];
+    reg [31:0] gemm_desc [0:8];
+    reg [31:0] ram_desc [0:5];
+    reg [31:0] spmv_desc [0:5];
+    reg [31:0] pool_desc [0:5];
+    reg [31:0] norm_desc [0:7];
+
+    // Sequencer program memory and entry point
+    reg [31:0] seq_imem [0:SEQ_WORDS-1];
+    reg [SEQ_ADDR_WIDTH-1:0] seq_entry;
+
+    // B tile cache: the CPU window and the core use the entry the engine
+    // last selected; CPU writes to it drop its tag
+    wire [$clog2(B_CACHE_ENTRIES)-1:0] b_sel;
+    wire        b_hit, b_miss;
+    reg  [7:0]  b_gen;
+    reg  [31:0] b_hits, b_misses;
+    wire [$clog2(N*P)-1:0] b_index = (rel_addr - MATRIX_B_BASE) >> 2;
+    wire [$clog2(N*P)-1:0] attn_v_index = (rel_addr - ATTN_V_BASE) >> 2;
+    wire b_cpu_write = mem_valid && mem_wstrb[0] && (access_matrix_b || access_cplx_b);
     
     // Matrix accelerator signals
-    wire accel_start = control_reg[0];
     wire accel_reset = control_reg[1];
     wire accel_done;
+    wire accel_ready;
+    wire accel_busy;
+    wire [M-1:0] accel_row_valid;
+
+    // BRAM interface signals for matrix accelerator
+    wire [$clog2(M*N)-1:0] bram_a_addr;
+    wire [DATA_WIDTH-1:0]  bram_a_rdata;
+    wire [$clog2(N*P)-1:0] bram_b_addr;
+    wire [DATA_WIDTH-1:0]  bram_b_rdata;
+    wire [$clog2(M*P)-1:0] bram_c_addr;
+    wire [ACC_WIDTH-1:0]   bram_c_rdata;
+    wire                   bram_c_we;
+    wire [ACC_WIDTH-1:0]   bram_c_wdata;
+    wire                   bram_a_re;
+    wire                   bram_b_re;
+    wire                   bram_wait;
+    wire [ACC_WIDTH-1:0]   bram_ci_wdata;
+    wire                   core_c_write = bram_c_we && !bram_wait;  // C write completed
+
+    // Start requests are latched so one job can be queued behind the running
+    // one; the core picks it up in the cycle it writes its last C element.
+    reg        start_pending;
+    reg  [M-1:0] row_req;  // Streamed A rows waiting to start
+    reg        done_flag;
+    reg [31:0] job_count;
+
+    // Result signatures: CRC-32 (reflected, as zlib) over every completed C
+    // write, each 32-bit element taken as four little-endian bytes. crc_acc
+    // covers the job in flight and is latched into crc_job with the core's
+    // done pulse, which coincides with the last write. Registers hold the
+    // raw CRC state; reads return it inverted.
+    localparam CRC_INIT = 32'hFFFFFFFF;
+    reg [31:0] crc_acc;
+    reg [31:0] crc_job;
+    reg [31:0] crc_run;
+
+    function [31:0] crc32_word;
+        input [31:0] crc;
+        input [31:0] data;
+        integer b;
+        reg [31:0] c;
+        begin
+            c = crc ^ data;
+            for (b = 0; b < 32; b = b + 1)
+                c = c[0] ? ((c >> 1) ^ 32'hEDB88320) : (c >> 1);
+            crc32_word = c;
+        end
+    endfunction
+
+    wire start_write = mem_valid && mem_wstrb[0] && access_control && mem_wdata[0];
+    wire batch_write = mem_valid && mem_wstrb[0] && access_control && mem_wdata[2];
+    wire seq_write   = mem_valid && mem_wstrb[0] && access_control && mem_wdata[3];
+    wire seq_signal  = mem_valid && (|mem_wstrb) && access_seq_signal;
+    wire gemm_write  = mem_valid && mem_wstrb[0] && access_control && mem_wdata[4];
+    wire spmv_write  = mem_valid && mem_wstrb[0] && access_control && mem_wdata[5];
+    wire pool_write  = mem_valid && mem_wstrb[0] && access_control && mem_wdata[6];
+    wire softmax_write = mem_valid && mem_wstrb[0] && access_control && mem_wdata[7];
+    wire norm_write  = mem_valid && mem_wstrb[1] && access_control && mem_wdata[8];
+    wire attn_write  = mem_valid && mem_wstrb[1] && access_control && mem_wdata[9];
+
+    // Tile engine signals
+    wire                       eng_op_ready;
+    wire                       eng_op_done;
+    wire [SPAD_ADDR_WIDTH-1:0] eng_spad_addr;
+    wire [31:0]                eng_spad_rdata;
+    wire                       eng_spad_we;
+    wire [3:0]                 eng_spad_wstrb;
+    wire [31:0]                eng_spad_wdata;
+    wire [15:0]                eng_rle_len;
+    wire                       eng_a_we;
+    wire [$clog2(M*N)-1:0]     eng_a_addr;
+    wire [DATA_WIDTH-1:0]      eng_a_wdata;
+    wire                       eng_b_we;
+    wire [$clog2(N*P)-1:0]     eng_b_addr;
+    wire [DATA_WIDTH-1:0]      eng_b_wdata;
+    wire [DATA_WIDTH-1:0]      eng_a_rdata;
+    wire [DATA_WIDTH-1:0]      eng_b_rdata;
+    wire [$clog2(M*P)-1:0]     eng_c_addr;
+    wire [ACC_WIDTH-1:0]       eng_c_rdata;
+    wire                       eng_c_we;
+    wire [ACC_WIDTH-1:0]       eng_c_wdata;
+    wire                       eng_core_start;
+    wire                       eng_core_accumulate;
+
+    // Sequencer signals
+    wire                      seq_busy;
+    wire                      seq_done;
+    wire [SEQ_ADDR_WIDTH-1:0] seq_pc;
+    wire [SEQ_ADDR_WIDTH-1:0] seq_imem_addr;
+    wire [31:0]               seq_imem_rdata;
+    wire                      seq_op_valid;
+    wire [2:0]                seq_op_code;
+    wire [31:0]               seq_op_addr;
+    wire [15:0]               seq_op_arg;
+
+    // Large GEMM walker signals
+    wire                      gemm_busy;
+    wire                      gemm_done;
+    wire                      gemm_op_valid;
+    wire [2:0]                gemm_op_code;
+    wire [31:0]               gemm_op_addr;
+    wire [15:0]               gemm_op_arg;
+    wire [7:0]                gemm_op_rows;
+    wire [7:0]                gemm_op_cols;
+
+    // Strided batch: CONTROL[2] walks BATCH_COUNT items of
+    // LOAD_A -> LOAD_B -> GEMM -> STORE_C, advancing each base by its stride
+    reg        batch_active;
+    reg        batch_last;   // Final STORE_C has been issued
+    reg [1:0]  batch_step;   // Next tile operation
+    reg [31:0] batch_left;
+    reg [31:0] batch_a, batch_b, batch_c;
+
+    // CSR SpMV (CONTROL[5]) runs on the RAM port and its own PE
+    wire spmv_busy;
+    wire spmv_done;
+    wire        spmv_ram_valid;
+    wire [31:0] spmv_ram_addr;
+    wire [31:0] spmv_ram_wdata;
+    wire [3:0]  spmv_ram_wstrb;
+
+    // Pooling (CONTROL[6]) rewrites scratchpad maps through its own port
+    wire pool_busy;
+    wire pool_done;
+    wire [SPAD_ADDR_WIDTH-1:0] pool_spad_addr;
+    wire                       pool_spad_we;
+    wire [31:0]                pool_spad_wdata;
+
+    // Softmax (CONTROL[7]) normalizes the rows of C in place
+    wire softmax_busy;
+    wire softmax_done;
+    wire [$clog2(M*P)-1:0] softmax_c_addr;
+    wire                   softmax_c_we;
+    wire [ACC_WIDTH-1:0]   softmax_c_wdata;
+
+    // LayerNorm/RMSNorm (CONTROL[8]) rewrites scratchpad rows
+    wire norm_busy;
+    wire norm_done;
+    wire [SPAD_ADDR_WIDTH-1:0] norm_spad_raddr;
+    wire [SPAD_ADDR_WIDTH-1:0] norm_param_addr;
+    wire [SPAD_ADDR_WIDTH-1:0] norm_spad_waddr;
+    wire                       norm_spad_we;
+    wire [31:0]                norm_spad_wdata;
+
+    // Fused attention (CONTROL[9]): S = Q * K^T with Q in A and K^T in B,
+    // softmax over the rows of S, then C = S * V with the probabilities
+    // copied into A and the V tile into B. Needs N == P.
+    reg [1:0] attn_step;
+    wire attn_active = (attn_step != ATTN_IDLE);
+
+    wire hw_seq_active = batch_active || seq_busy || gemm_busy || spmv_busy || pool_busy ||
+                         softmax_busy || norm_busy || attn_active;
+
+    // Batches, sequencer programs and tiled GEMMs drive the core through the
+    // tile engine, so they also wait out CPU-started and streamed jobs
+    wire core_idle    = !start_pending && !(|row_req) && !accel_busy;
+    wire batch_start  = batch_write && !hw_seq_active && core_idle && (batch_desc[BATCH_COUNT] != 0);
+    wire batch_finish = batch_active && batch_last && eng_op_done;
+    wire seq_start    = seq_write && !hw_seq_active && core_idle;
+    wire gemm_start   = gemm_write && !hw_seq_active && core_idle && (gemm_desc[GEMM_M][15:0] != 0) &&
+                        (gemm_desc[GEMM_N][15:0] != 0) && (gemm_desc[GEMM_P][15:0] != 0);
+    wire spmv_start   = spmv_write && !hw_seq_active && (spmv_desc[SPMV_ROWS][15:0] != 0);
+    // A descriptor the pooling unit cannot walk is ignored, like a zero-sized GEMM
+    wire [3:0] pool_window = pool_desc[POOL_MODE][3:0];
+    wire pool_start   = pool_write && !hw_seq_active &&
+                        (pool_window == 4'd2 || pool_window == 4'd3) &&
+                        (pool_desc[POOL_MODE][11:8] != 0) && (pool_desc[POOL_CHANNELS][15:0] != 0) &&
+                        (pool_desc[POOL_HEIGHT][15:0] >= pool_window) &&
+                        (pool_desc[POOL_WIDTH][15:0] >= pool_window);
+    wire norm_start   = norm_write && !hw_seq_active && (norm_desc[NORM_ROWS][15:0] != 0) &&
+                        (norm_desc[NORM_LEN][15:0] > 1);
+    // The stages follow accel_done, so no other core job may be in flight
+    wire attn_start   = attn_write && !hw_seq_active && core_idle;
+    wire attn_scores  = (attn_step == ATTN_QK) && accel_done;
+    wire attn_load_pv = (attn_step == ATTN_SOFTMAX) && softmax_done;
+    wire attn_finish  = (attn_step == ATTN_PV) && accel_done;
+    // A CPU-started softmax must not race core writes to the C tile
+    wire softmax_start = (softmax_write && !hw_seq_active && core_idle) || attn_scores;
+
+    wire        batch_op_valid = batch_active && !batch_last;
+    wire [31:0] batch_op_addr  = (batch_step == TILE_LOAD_A) ? batch_a :
+                                 (batch_step == TILE_LOAD_B) ? batch_b : batch_c;
+    wire [15:0] batch_op_arg   = (batch_step == TILE_LOAD_A) ? N :
+                                 (batch_step == TILE_LOAD_B) ? P :
+                                 (batch_step == TILE_GEMM)   ? 0 : P*4;
+    wire        batch_op_issue = batch_op_valid && eng_op_ready;
+
+    // The batch walker, GEMM walker and sequencer never run together;
+    // whichever is active owns the tile engine. Only the GEMM walker issues
+    // partial edge tiles.
+    wire        eng_op_valid = batch_active ? batch_op_valid :
+                               gemm_busy    ? gemm_op_valid  : seq_op_valid;
+    wire [2:0]  eng_op_code  = batch_active ? {1'b0, batch_step} :
+                               gemm_busy    ? gemm_op_code   : seq_op_code;
+    wire [31:0] eng_op_addr  = batch_active ? batch_op_addr :
+                               gemm_busy    ? gemm_op_addr   : seq_op_addr;
+    wire [15:0] eng_op_arg   = batch_active ? batch_op_arg :
+                               gemm_busy    ? gemm_op_arg    : seq_op_arg;
+    wire [7:0]  eng_op_rows  = gemm_busy ? gemm_op_rows :
+                               (eng_op_code == TILE_LOAD_B) ? N : M;
+    wire [7:0]  eng_op_cols  = gemm_busy ? gemm_op_cols :
+                               (eng_op_code == TILE_LOAD_A) ? N : P;
+
+    // Row streaming (CONFIG[24]): writing the last element of an A row
+    // requests that C row. Requests queue in row_req and are issued to the
+    // core as single-row jobs, lowest row first; full jobs take priority.
+    wire stream_en = config_reg[24];
+    wire ram_direct = config_reg[25];
+    wire complex_en = config_reg[26];
+    wire [2:0] pe_op = config_reg[29:27];   // See pe.v
+
+    // Edge tiles are padded so the padding never wins a min/max-plus
+    // reduction: no real a + b exceeds 127 + 127 or falls below -128 + -128
+    wire [DATA_WIDTH-1:0] eng_pad = (pe_op == 3'd2) ? 8'h7F :
+                                    (pe_op == 3'd3) ? 8'h80 : 8'h00;
+    reg  job_ram;          // Running job accesses operands in RAM
+
+    wire [31:0] a_index = (rel_addr - MATRIX_A_BASE) >> 2;
+    wire a_row_write = stream_en && mem_valid && mem_wstrb[0] && access_matrix_a &&
+                       (a_index % N == N-1);
+
+    function [$clog2(M)-1:0] first_row;
+        input [M-1:0] req;
+        integer r;
+        begin
+            first_row = 0;
+            for (r = M-1; r >= 0; r = r - 1)
+                if (req[r]) first_row = r;
+        end
+    endfunction
+
+    // Unit chaining (CHAIN_CTRL): with OUT_EN every C element the core
+    // writes is requantized (arithmetic shift by SHIFT, saturated to
+    // DATA_WIDTH) and queued for the next unit. A job only starts once the
+    // FIFO has room for all of its results, and a job already running when
+    // OUT_EN is set stalls its C writes while the FIFO is full, so nothing
+    // is ever dropped.
+    // With IN_EN, elements arriving from the previous unit fill A in
+    // row-major order and each completed row is requested like a streamed
+    // row. Forwarded rows line up with A rows only when N == P.
+    wire       chain_out_en = chain_ctrl[0];
+    wire       chain_in_en  = chain_ctrl[1];
+    wire [4:0] chain_shift  = chain_ctrl[12:8];
+
+    function [DATA_WIDTH-1:0] requant;
+        input signed [ACC_WIDTH-1:0] value;
+        input [4:0] shift;
+        reg signed [ACC_WIDTH-1:0] shifted;
+        begin
+            shifted = value >>> shift;
+            if (shifted > $signed((1 << (DATA_WIDTH-1)) - 1))
+                requant = {1'b0, {(DATA_WIDTH-1){1'b1}}};
+            else if (shifted < -$signed(1 << (DATA_WIDTH-1)))
+                requant = {1'b1, {(DATA_WIDTH-1){1'b0}}};
+            else
+                requant = shifted[DATA_WIDTH-1:0];
+        end
+    endfunction
+
+    wire [$clog2(CHAIN_DEPTH+1)-1:0] chain_count;
+    wire [7:0] chain_level = chain_count;
+    wire chain_empty;
+    wire chain_full;
+    wire chain_push  = chain_out_en && core_c_write;
+    wire chain_stall = chain_out_en && bram_c_we && chain_full;
+
+    wire full_req = start_pending || eng_core_start;
+    wire accel_row_mode = !full_req;
+    wire [$clog2(M)-1:0] accel_start_row = first_row(row_req);
+
+    // Free entries left once this cycle's push (if any) has landed
+    wire [$clog2(CHAIN_DEPTH+1):0] chain_free = CHAIN_DEPTH - chain_count - chain_push;
+    wire chain_room = !chain_out_en || (chain_free >= (full_req ? M*P : P));
+    wire accel_start = (full_req || (|row_req)) && chain_room;
+    wire accel_accumulate = eng_core_start && eng_core_accumulate;
+    wire start_accept = accel_start && accel_ready;
+
+    // Finished C rows may be drained while later rows compute. Rows are only
+    // reported once a queued start has been taken, so they always belong to
+    // the most recently started job.
+    // A row whose chained A operands are partly replaced is not reported
+    // either: its C still belongs to the previous frame.
+    reg  [M-1:0] row_filling;
+    wire [7:0] status_rows = start_pending ? {M{1'b0}} : (accel_row_valid & ~row_req & ~row_filling);
+
+    // Rows of the running job still to be written; the chain input must not
+    // overwrite their A operands. job_rows is updated on accept, together
+    // with row_valid.
+    reg  [M-1:0] job_rows;
+    wire [M-1:0] rows_inflight = accel_busy ? (job_rows & ~accel_row_valid) : {M{1'b0}};
+
+    reg  [$clog2(M*N)-1:0] chain_a_idx;
+    wire [$clog2(M)-1:0]   chain_row = chain_a_idx / N;
+    wire chain_in_fire = chain_in_valid && chain_in_ready;
+
+    assign chain_in_ready = chain_in_en && !accel_reset &&
+                            !row_req[chain_row] && !rows_inflight[chain_row];
+    assign chain_out_valid = !chain_empty;
     
     // Always ready for register/memory accesses
     assign mem_ready = mem_valid;
@@ -67,37 +568,234 @@ module matrix_accel_wrapper #(
             if (access_control) begin
                 read_data = control_reg;
             end else if (access_status) begin
-                read_data = {30'h0, accel_done, ~accel_done}; // [1:0] = {done, busy}
+                read_data = {16'h0, status_rows, 5'h0, start_pending, done_flag, accel_busy | accel_start | hw_seq_active}; // [15:8] = rows, [2:0] = {pending, done, busy}
             end else if (access_config) begin
                 read_data = config_reg;
+            end else if (access_job_count) begin
+                read_data = job_count;
+            end else if (access_batch_desc) begin
+                read_data = batch_desc[batch_desc_index];
+            end else if (access_gemm_desc) begin
+                read_data = gemm_desc[gemm_desc_index];
+            end else if (access_ram_desc) begin
+                read_data = ram_desc[ram_desc_index];
+            end else if (access_spmv_desc) begin
+                read_data = spmv_desc[spmv_desc_index];
+            end else if (access_pool_desc) begin
+                read_data = pool_desc[pool_desc_index];
+            end else if (access_norm_desc) begin
+                read_data = norm_desc[norm_desc_index];
+            end else if (access_scratch) begin
+                read_data = scratch[scratch_index];
+            end else if (access_seq_entry) begin
+                read_data = seq_entry;
+            end else if (access_seq_pc) begin
+                read_data = seq_pc;
+            end else if (access_b_gen) begin
+                read_data = {24'h0, b_gen};
+            end else if (access_b_hits) begin
+                read_data = b_hits;
+            end else if (access_b_misses) begin
+                read_data = b_misses;
+            end else if (access_rle_len) begin
+                read_data = {16'h0, eng_rle_len};
+            end else if (access_crc_job) begin
+                read_data = ~crc_job;
+            end else if (access_crc_run) begin
+                read_data = ~crc_run;
+            end else if (access_gf_poly) begin
+                read_data = {24'h0, gf_poly};
+            end else if (access_softmax_cfg) begin
+                read_data = {27'h0, softmax_shift};
+            end else if (access_chain_ctrl) begin
+                read_data = {chain_level, 8'h0, chain_ctrl}; // [31:24] = FIFO level
+            end else if (access_seq_imem) begin
+                read_data = seq_imem[seq_imem_index];
             end else if (access_matrix_a) begin
                 // Read from matrix A
                 read_data = {24'h0, matrix_a[(rel_addr - MATRIX_A_BASE) >> 2]};
             end else if (access_matrix_b) begin
                 // Read from matrix B
-                read_data = {24'h0, matrix_b[(rel_addr - MATRIX_B_BASE) >> 2]};
+                read_data = {24'h0, matrix_b[b_sel*N*P + b_index]};
+            end else if (access_attn_v) begin
+                read_data = {24'h0, matrix_v[attn_v_index]};
             end else if (access_matrix_c) begin
                 // Read from matrix C results
                 read_data = matrix_c[(rel_addr - MATRIX_C_BASE) >> 2];
+            end else if (access_cplx_a) begin
+                read_data = {16'h0, matrix_ai[cplx_a_index], matrix_a[cplx_a_index]};
+            end else if (access_cplx_b) begin
+                read_data = {16'h0, matrix_bi[cplx_b_index], matrix_b[b_sel*N*P + cplx_b_index]};
+            end else if (access_cplx_c) begin
+                read_data = {sat16(matrix_ci[cplx_c_index]), sat16(matrix_c[cplx_c_index])};
+            end else if (access_c_imag) begin
+                read_data = matrix_ci[c_imag_index];
             end
         end
     end
     
     // Write logic
     integer i;
+    initial begin
+        for (i = 0; i < SCRATCH_WORDS; i = i + 1) scratch[i] = 32'h0;
+    end
+
     always @(posedge clk) begin
         if (!rst_n) begin
             control_reg <= 32'h0;
             status_reg <= 32'h0;
             config_reg <= {16'h0, P[7:0], N[7:0]}; // Default config
+            gf_poly <= 8'h1D;
+            softmax_shift <= 5'h0;
             
             // Initialize matrices to zero
             for (i = 0; i < M*N; i = i + 1) matrix_a[i] <= 8'h0;
-            for (i = 0; i < N*P; i = i + 1) matrix_b[i] <= 8'h0;
+            for (i = 0; i < B_CACHE_ENTRIES*N*P; i = i + 1) matrix_b[i] <= 8'h0;
             for (i = 0; i < M*P; i = i + 1) matrix_c[i] <= 32'h0;
+            for (i = 0; i < M*P; i = i + 1) matrix_ci[i] <= 32'h0;
+            for (i = 0; i < N*P; i = i + 1) matrix_v[i] <= 8'h0;
+            for (i = 0; i < M*N; i = i + 1) matrix_ai[i] <= 8'h0;
+            for (i = 0; i < N*P; i = i + 1) matrix_bi[i] <= 8'h0;
+
+            for (i = 0; i < 7; i = i + 1) batch_desc[i] <= 32'h0;
+            for (i = 0; i < 9; i = i + 1) gemm_desc[i] <= 32'h0;
+            for (i = 0; i < 6; i = i + 1) ram_desc[i] <= 32'h0;
+            for (i = 0; i < 6; i = i + 1) spmv_desc[i] <= 32'h0;
+            for (i = 0; i < 6; i = i + 1) pool_desc[i] <= 32'h0;
+            for (i = 0; i < 8; i = i + 1) norm_desc[i] <= 32'h0;
+            job_ram <= 1'b0;
+
+            start_pending <= 1'b0;
+            done_flag <= 1'b0;
+            job_count <= 32'h0;
+            row_req <= {M{1'b0}};
+            batch_active <= 1'b0;
+            batch_last <= 1'b0;
+            attn_step <= ATTN_IDLE;
+            batch_step <= TILE_LOAD_A;
+            batch_left <= 32'h0;
+            batch_a <= 32'h0;
+            batch_b <= 32'h0;
+            batch_c <= 32'h0;
+            seq_entry <= 0;
+            chain_ctrl <= 16'h0;
+            b_gen <= 8'h0;
+            b_hits <= 32'h0;
+            b_misses <= 32'h0;
+            chain_a_idx <= 0;
+            row_filling <= {M{1'b0}};
+            job_rows <= {M{1'b0}};
+            crc_acc <= CRC_INIT;
+            crc_job <= CRC_INIT;
+            crc_run <= CRC_INIT;
         end else begin
-            // Clear start bit automatically after one cycle
+            // Clear start bits automatically after one cycle
             if (control_reg[0]) control_reg[0] <= 1'b0;
+            if (control_reg[2]) control_reg[2] <= 1'b0;
+            if (control_reg[3]) control_reg[3] <= 1'b0;
+            if (control_reg[4]) control_reg[4] <= 1'b0;
+            if (control_reg[5]) control_reg[5] <= 1'b0;
+            if (control_reg[6]) control_reg[6] <= 1'b0;
+            if (control_reg[7]) control_reg[7] <= 1'b0;
+            if (control_reg[8]) control_reg[8] <= 1'b0;
+            if (control_reg[9]) control_reg[9] <= 1'b0;
+
+            // Job bookkeeping: done stays set until the next job is accepted
+            if (accel_reset) begin
+                start_pending <= 1'b0;
+                done_flag <= 1'b0;
+                job_count <= 32'h0;
+                row_req <= {M{1'b0}};
+                batch_active <= 1'b0;
+                batch_last <= 1'b0;
+                attn_step <= ATTN_IDLE;
+                chain_a_idx <= 0;
+                row_filling <= {M{1'b0}};
+                job_ram <= 1'b0;
+                b_hits <= 32'h0;
+                b_misses <= 32'h0;
+                crc_acc <= CRC_INIT;
+                crc_job <= CRC_INIT;
+                crc_run <= CRC_INIT;
+            end else begin
+                // Both products of a fused attention queue like CPU starts
+                if (start_write || attn_start || attn_load_pv) start_pending <= 1'b1;
+                else if (start_accept && !accel_row_mode) start_pending <= 1'b0;
+
+                if (start_accept && accel_row_mode) row_req[accel_start_row] <= 1'b0;
+                if (a_row_write) row_req[a_index / N] <= 1'b1;
+                if (chain_in_fire && (chain_a_idx % N == N-1)) row_req[chain_row] <= 1'b1;
+
+                // From a row's first chained element until it is requested
+                if (chain_in_fire) begin
+                    if (chain_a_idx % N == N-1) row_filling[chain_row] <= 1'b0;
+                    else if (chain_a_idx % N == 0) row_filling[chain_row] <= 1'b1;
+                end
+
+                // CPU-started full jobs run in place when CONFIG[25] is set
+                if (start_accept) job_ram <= ram_direct && start_pending && !eng_core_start;
+
+                if (start_accept) begin
+                    if (accel_row_mode) job_rows <= {{(M-1){1'b0}}, 1'b1} << accel_start_row;
+                    else job_rows <= {M{1'b1}};
+                end
+
+                if (b_hit) b_hits <= b_hits + 1;
+                if (b_miss) b_misses <= b_misses + 1;
+
+                if (chain_in_fire) chain_a_idx <= (chain_a_idx == M*N-1) ? 0 : chain_a_idx + 1;
+
+                // During a batch or program, done is only raised once the
+                // whole sequence has finished
+                if (batch_start || seq_start || gemm_start || spmv_start || pool_start || softmax_start || norm_start || attn_start || (start_accept && !hw_seq_active)) done_flag <= 1'b0;
+                else if (batch_finish || seq_done || gemm_done || spmv_done || pool_done || (softmax_done && !attn_active) || norm_done ||
+                         attn_finish || (accel_done && !hw_seq_active)) done_flag <= 1'b1;
+
+                if (accel_done) job_count <= job_count + 1;
+
+                if (accel_done) begin
+                    crc_job <= crc32_word(crc_acc, bram_c_wdata);
+                    crc_acc <= CRC_INIT;
+                end else if (core_c_write) begin
+                    crc_acc <= crc32_word(crc_acc, bram_c_wdata);
+                end
+                if (core_c_write) crc_run <= crc32_word(crc_run, bram_c_wdata);
+
+                if (batch_start) begin
+                    batch_active <= 1'b1;
+                    batch_last <= 1'b0;
+                    batch_step <= TILE_LOAD_A;
+                    batch_left <= batch_desc[BATCH_COUNT];
+                    batch_a <= batch_desc[BATCH_A_BASE];
+                    batch_b <= batch_desc[BATCH_B_BASE];
+                    batch_c <= batch_desc[BATCH_C_BASE];
+                end else if (batch_finish) begin
+                    batch_active <= 1'b0;
+                    batch_last <= 1'b0;
+                end else if (batch_op_issue) begin
+                    batch_step <= batch_step + 1;
+                    if (batch_step == TILE_STORE_C) begin
+                        batch_left <= batch_left - 1;
+                        batch_a <= batch_a + batch_desc[BATCH_A_STRIDE];
+                        batch_b <= batch_b + batch_desc[BATCH_B_STRIDE];
+                        batch_c <= batch_c + batch_desc[BATCH_C_STRIDE];
+                        if (batch_left == 1) batch_last <= 1'b1;
+                    end
+                end
+
+                // Q0.7 probabilities are valid 8-bit operands as they are
+                if (attn_start) begin
+                    attn_step <= ATTN_QK;
+                end else if (attn_scores) begin
+                    attn_step <= ATTN_SOFTMAX;
+                end else if (attn_load_pv) begin
+                    attn_step <= ATTN_PV;
+                    for (i = 0; i < M*N; i = i + 1) matrix_a[i] <= matrix_c[i][DATA_WIDTH-1:0];
+                    for (i = 0; i < N*P; i = i + 1) matrix_b[b_sel*N*P + i] <= matrix_v[i];
+                end else if (attn_finish) begin
+                    attn_step <= ATTN_IDLE;
+                end
+            end
             
             if (mem_valid && |mem_wstrb) begin  // Write operation
                 if (access_control) begin
@@ -115,53 +813,402 @@ module matrix_accel_wrapper #(
                     if (mem_wstrb[0]) matrix_a[(rel_addr - MATRIX_A_BASE) >> 2] <= mem_wdata[7:0];
                 end else if (access_matrix_b) begin
                     // Write to matrix B (only write lowest byte)
-                    if (mem_wstrb[0]) matrix_b[(rel_addr - MATRIX_B_BASE) >> 2] <= mem_wdata[7:0];
+                    if (mem_wstrb[0]) matrix_b[b_sel*N*P + b_index] <= mem_wdata[7:0];
+                end else if (access_attn_v) begin
+                    if (mem_wstrb[0]) matrix_v[attn_v_index] <= mem_wdata[7:0];
+                end else if (access_cplx_a) begin
+                    if (mem_wstrb[0]) matrix_a[cplx_a_index] <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) matrix_ai[cplx_a_index] <= mem_wdata[15:8];
+                end else if (access_cplx_b) begin
+                    if (mem_wstrb[0]) matrix_b[b_sel*N*P + cplx_b_index] <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) matrix_bi[cplx_b_index] <= mem_wdata[15:8];
+                end else if (access_batch_desc) begin
+                    if (mem_wstrb[0]) batch_desc[batch_desc_index][7:0]   <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) batch_desc[batch_desc_index][15:8]  <= mem_wdata[15:8];
+                    if (mem_wstrb[2]) batch_desc[batch_desc_index][23:16] <= mem_wdata[23:16];
+                    if (mem_wstrb[3]) batch_desc[batch_desc_index][31:24] <= mem_wdata[31:24];
+                end else if (access_gemm_desc) begin
+                    if (mem_wstrb[0]) gemm_desc[gemm_desc_index][7:0]   <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) gemm_desc[gemm_desc_index][15:8]  <= mem_wdata[15:8];
+                    if (mem_wstrb[2]) gemm_desc[gemm_desc_index][23:16] <= mem_wdata[23:16];
+                    if (mem_wstrb[3]) gemm_desc[gemm_desc_index][31:24] <= mem_wdata[31:24];
+                end else if (access_ram_desc) begin
+                    if (mem_wstrb[0]) ram_desc[ram_desc_index][7:0]   <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) ram_desc[ram_desc_index][15:8]  <= mem_wdata[15:8];
+                    if (mem_wstrb[2]) ram_desc[ram_desc_index][23:16] <= mem_wdata[23:16];
+                    if (mem_wstrb[3]) ram_desc[ram_desc_index][31:24] <= mem_wdata[31:24];
+                end else if (access_spmv_desc) begin
+                    if (mem_wstrb[0]) spmv_desc[spmv_desc_index][7:0]   <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) spmv_desc[spmv_desc_index][15:8]  <= mem_wdata[15:8];
+                    if (mem_wstrb[2]) spmv_desc[spmv_desc_index][23:16] <= mem_wdata[23:16];
+                    if (mem_wstrb[3]) spmv_desc[spmv_desc_index][31:24] <= mem_wdata[31:24];
+                end else if (access_pool_desc) begin
+                    if (mem_wstrb[0]) pool_desc[pool_desc_index][7:0]   <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) pool_desc[pool_desc_index][15:8]  <= mem_wdata[15:8];
+                    if (mem_wstrb[2]) pool_desc[pool_desc_index][23:16] <= mem_wdata[23:16];
+                    if (mem_wstrb[3]) pool_desc[pool_desc_index][31:24] <= mem_wdata[31:24];
+                end else if (access_norm_desc) begin
+                    if (mem_wstrb[0]) norm_desc[norm_desc_index][7:0]   <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) norm_desc[norm_desc_index][15:8]  <= mem_wdata[15:8];
+                    if (mem_wstrb[2]) norm_desc[norm_desc_index][23:16] <= mem_wdata[23:16];
+                    if (mem_wstrb[3]) norm_desc[norm_desc_index][31:24] <= mem_wdata[31:24];
+                end else if (access_scratch) begin
+                    if (mem_wstrb[0]) scratch[scratch_index][7:0]   <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) scratch[scratch_index][15:8]  <= mem_wdata[15:8];
+                    if (mem_wstrb[2]) scratch[scratch_index][23:16] <= mem_wdata[23:16];
+                    if (mem_wstrb[3]) scratch[scratch_index][31:24] <= mem_wdata[31:24];
+                end else if (access_seq_entry) begin
+                    if (mem_wstrb[0]) seq_entry <= mem_wdata[SEQ_ADDR_WIDTH-1:0];
+                end else if (access_b_gen) begin
+                    if (mem_wstrb[0]) b_gen <= mem_wdata[7:0];
+                end else if (access_b_hits) begin
+                    b_hits <= 32'h0;
+                end else if (access_b_misses) begin
+                    b_misses <= 32'h0;
+                end else if (access_crc_run) begin
+                    crc_run <= CRC_INIT;
+                end else if (access_gf_poly) begin
+                    if (mem_wstrb[0]) gf_poly <= mem_wdata[7:0];
+                end else if (access_softmax_cfg) begin
+                    if (mem_wstrb[0]) softmax_shift <= mem_wdata[4:0];
+                end else if (access_chain_ctrl) begin
+                    // Reconfiguring the link restarts the A fill at element 0
+                    if (mem_wstrb[0]) chain_ctrl[7:0]  <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) chain_ctrl[15:8] <= mem_wdata[15:8];
+                    chain_a_idx <= 0;
+                    row_filling <= {M{1'b0}};
+                end else if (access_seq_imem) begin
+                    if (mem_wstrb[0]) seq_imem[seq_imem_index][7:0]   <= mem_wdata[7:0];
+                    if (mem_wstrb[1]) seq_imem[seq_imem_index][15:8]  <= mem_wdata[15:8];
+                    if (mem_wstrb[2]) seq_imem[seq_imem_index][23:16] <= mem_wdata[23:16];
+                    if (mem_wstrb[3]) seq_imem[seq_imem_index][31:24] <= mem_wdata[31:24];
                 end
             end
+
+            // Tile engine transfers
+            if (eng_a_we) matrix_a[eng_a_addr] <= eng_a_wdata;
+            if (eng_b_we) matrix_b[b_sel*N*P + eng_b_addr] <= eng_b_wdata;
+            if (eng_spad_we) begin
+                if (eng_spad_wstrb[0]) scratch[eng_spad_addr][7:0]   <= eng_spad_wdata[7:0];
+                if (eng_spad_wstrb[1]) scratch[eng_spad_addr][15:8]  <= eng_spad_wdata[15:8];
+                if (eng_spad_wstrb[2]) scratch[eng_spad_addr][23:16] <= eng_spad_wdata[23:16];
+                if (eng_spad_wstrb[3]) scratch[eng_spad_addr][31:24] <= eng_spad_wdata[31:24];
+            end
+            if (pool_spad_we) scratch[pool_spad_addr] <= pool_spad_wdata;
+            if (norm_spad_we) scratch[norm_spad_waddr] <= norm_spad_wdata;
+            if (chain_in_fire) matrix_a[chain_a_idx] <= chain_in_data;
         end
     end
 
     // Connect matrix accelerator - we need to bridge between BRAM interface and our arrays
     
-    // BRAM interface signals for matrix accelerator
-    wire [$clog2(M*N)-1:0] bram_a_addr;
-    wire [DATA_WIDTH-1:0]  bram_a_rdata;
-    wire [$clog2(N*P)-1:0] bram_b_addr;
-    wire [DATA_WIDTH-1:0]  bram_b_rdata;
-    wire [$clog2(M*P)-1:0] bram_c_addr;
-    wire                   bram_c_we;
-    wire [ACC_WIDTH-1:0]   bram_c_wdata;
-    
+    // In-place jobs: the core's A read, B read and C write happen in
+    // different FSM states, so one RAM port serves all three. A and B are
+    // row-major bytes, C row-major 32-bit words; the core waits whenever
+    // the port is not granted.
+    wire [31:0] ram_a_byte = ram_desc[RAM_A_ADDR] + (bram_a_addr / N) * ram_desc[RAM_LDA] + (bram_a_addr % N);
+    wire [31:0] ram_b_byte = ram_desc[RAM_B_ADDR] + (bram_b_addr % N) * ram_desc[RAM_LDB] + (bram_b_addr / N);
+    wire [31:0] ram_c_byte = ram_desc[RAM_C_ADDR] + (bram_c_addr / P) * ram_desc[RAM_LDC] + (bram_c_addr % P) * 4;
+    wire [31:0] ram_byte   = bram_c_we ? ram_c_byte : bram_a_re ? ram_a_byte : ram_b_byte;
+    wire [31:0] ram_shifted = ram_rdata >> (ram_byte[1:0] * 8);
+
+    // The SpMV unit owns the port while it runs; an in-place job started
+    // meanwhile waits for it
+    wire job_ram_valid = job_ram && (bram_a_re || bram_b_re || bram_c_we);
+
+    assign ram_valid = spmv_busy ? spmv_ram_valid : job_ram_valid;
+    assign ram_addr  = spmv_busy ? spmv_ram_addr : {ram_byte[31:2], 2'b00};
+    assign ram_wdata = spmv_busy ? spmv_ram_wdata : bram_c_wdata;
+    assign ram_wstrb = spmv_busy ? spmv_ram_wstrb : bram_c_we ? 4'hF : 4'h0;
+    assign bram_wait = (job_ram_valid && (spmv_busy || !ram_ready)) || chain_stall;
+
     // Connect matrix data to BRAM interface
-    assign bram_a_rdata = matrix_a[bram_a_addr];
-    assign bram_b_rdata = matrix_b[bram_b_addr];
+    assign bram_a_rdata = job_ram ? ram_shifted[DATA_WIDTH-1:0] : matrix_a[bram_a_addr];
+    assign bram_b_rdata = job_ram ? ram_shifted[DATA_WIDTH-1:0] : matrix_b[b_sel*N*P + bram_b_addr];
+
+    // XNOR-popcount jobs take a whole A row and B column per step, always
+    // from the operand buffers. The reads start at the row/column base
+    // (k = 0 there), so other jobs stepping k never index past the buffers.
+    wire [N*DATA_WIDTH-1:0] bram_a_row;
+    wire [N*DATA_WIDTH-1:0] bram_b_col;
+    wire [$clog2(M*N)-1:0] bin_a_base = (bram_a_addr / N) * N;
+    wire [$clog2(N*P)-1:0] bin_b_base = (bram_b_addr / N) * N;
+    genvar g;
+    generate
+        for (g = 0; g < N; g = g + 1) begin : g_bin
+            assign bram_a_row[g*DATA_WIDTH +: DATA_WIDTH] = matrix_a[bin_a_base + g];
+            assign bram_b_col[g*DATA_WIDTH +: DATA_WIDTH] = matrix_b[b_sel*N*P + bin_b_base + g];
+        end
+    endgenerate
     
-    // Write results back to matrix C
+    // Accumulating jobs read the previous C value
+    assign bram_c_rdata = matrix_c[bram_c_addr];
+
+    // Write results back to matrix C (core results or element-wise updates).
+    // In-place results are mirrored here too, so STATUS rows and the C
+    // window stay meaningful.
     always @(posedge clk) begin
-        if (bram_c_we) begin
+        if (core_c_write) begin
             matrix_c[bram_c_addr] <= bram_c_wdata;
+            matrix_ci[bram_c_addr] <= bram_ci_wdata;
+        end else if (eng_c_we) begin
+            matrix_c[eng_c_addr] <= eng_c_wdata;
+        end else if (softmax_c_we) begin
+            matrix_c[softmax_c_addr] <= softmax_c_wdata;
         end
     end
 
+    // Tile engine moves operands between the scratchpad and the core buffers
+    assign eng_spad_rdata = scratch[eng_spad_addr];
+    assign eng_c_rdata = matrix_c[eng_c_addr];
+    assign eng_a_rdata = matrix_a[eng_a_addr];
+    assign eng_b_rdata = matrix_b[b_sel*N*P + eng_b_addr];
+
+    tile_engine #(
+        .DATA_WIDTH(DATA_WIDTH),
+        .ACC_WIDTH(ACC_WIDTH),
+        .M(M),
+        .N(N),
+        .P(P),
+        .SPAD_ADDR_WIDTH(SPAD_ADDR_WIDTH),
+        .B_ENTRIES(B_CACHE_ENTRIES)
+    ) tile_engine_inst (
+        .clk(clk),
+        .rst_n(rst_n & ~accel_reset),
+        .op_valid(eng_op_valid),
+        .op_code(eng_op_code),
+        .op_addr(eng_op_addr),
+        .op_arg(eng_op_arg),
+        .op_rows(eng_op_rows),
+        .op_cols(eng_op_cols),
+        .op_ready(eng_op_ready),
+        .op_done(eng_op_done),
+        .spad_addr(eng_spad_addr),
+        .spad_rdata(eng_spad_rdata),
+        .spad_we(eng_spad_we),
+        .spad_wstrb(eng_spad_wstrb),
+        .spad_wdata(eng_spad_wdata),
+        .rle_len(eng_rle_len),
+        .a_we(eng_a_we),
+        .a_addr(eng_a_addr),
+        .a_wdata(eng_a_wdata),
+        .b_we(eng_b_we),
+        .b_addr(eng_b_addr),
+        .b_wdata(eng_b_wdata),
+        .a_rdata(eng_a_rdata),
+        .b_rdata(eng_b_rdata),
+        .pad_data(eng_pad),
+        .b_sel(b_sel),
+        .b_gen(b_gen),
+        .b_invalidate(b_cpu_write || attn_load_pv),
+        .b_hit(b_hit),
+        .b_miss(b_miss),
+        .c_addr(eng_c_addr),
+        .c_rdata(eng_c_rdata),
+        .c_we(eng_c_we),
+        .c_wdata(eng_c_wdata),
+        .core_start(eng_core_start),
+        .core_accumulate(eng_core_accumulate),
+        .core_accept(start_accept && full_req),
+        .core_done(accel_done)
+    );
+
+    // Result-forwarding FIFO towards the next unit
+    sync_fifo #(
+        .WIDTH(DATA_WIDTH),
+        .DEPTH(CHAIN_DEPTH)
+    ) chain_fifo (
+        .clk(clk),
+        .rst_n(rst_n & ~accel_reset),
+        .push(chain_push),
+        .push_data(requant(bram_c_wdata, chain_shift)),
+        .pop(chain_out_ready),
+        .pop_data(chain_out_data),
+        .count(chain_count),
+        .full(chain_full),
+        .empty(chain_empty)
+    );
+
+    // Micro-sequencer runs programs from seq_imem through the tile engine
+    assign seq_imem_rdata = seq_imem[seq_imem_addr];
+
+    accel_sequencer #(
+        .IMEM_ADDR_WIDTH(SEQ_ADDR_WIDTH)
+    ) sequencer_inst (
+        .clk(clk),
+        .rst_n(rst_n & ~accel_reset),
+        .start(seq_start),
+        .start_pc(seq_entry),
+        .signal(seq_signal),
+        .busy(seq_busy),
+        .done(seq_done),
+        .pc_out(seq_pc),
+        .imem_addr(seq_imem_addr),
+        .imem_rdata(seq_imem_rdata),
+        .op_valid(seq_op_valid),
+        .op_code(seq_op_code),
+        .op_addr(seq_op_addr),
+        .op_arg(seq_op_arg),
+        .op_ready(eng_op_ready),
+        .op_done(eng_op_done)
+    );
+
+    // Large GEMM walker tiles whole scratchpad matrices over the core
+    tiled_gemm #(
+        .TM(M),
+        .TN(N),
+        .TP(P)
+    ) tiled_gemm_inst (
+        .clk(clk),
+        .rst_n(rst_n & ~accel_reset),
+        .start(gemm_start),
+        .dim_m(gemm_desc[GEMM_M][15:0]),
+        .dim_n(gemm_desc[GEMM_N][15:0]),
+        .dim_p(gemm_desc[GEMM_P][15:0]),
+        .a_base(gemm_desc[GEMM_A_BASE]),
+        .b_base(gemm_desc[GEMM_B_BASE]),
+        .c_base(gemm_desc[GEMM_C_BASE]),
+        .lda(gemm_desc[GEMM_LDA][15:0]),
+        .ldb(gemm_desc[GEMM_LDB][15:0]),
+        .ldc(gemm_desc[GEMM_LDC][15:0]),
+        .busy(gemm_busy),
+        .done(gemm_done),
+        .op_valid(gemm_op_valid),
+        .op_code(gemm_op_code),
+        .op_addr(gemm_op_addr),
+        .op_arg(gemm_op_arg),
+        .op_rows(gemm_op_rows),
+        .op_cols(gemm_op_cols),
+        .op_ready(eng_op_ready),
+        .op_done(eng_op_done)
+    );
+
+    pool_unit #(
+        .SPAD_ADDR_WIDTH(SPAD_ADDR_WIDTH)
+    ) pool_inst (
+        .clk(clk),
+        .rst_n(rst_n & ~accel_reset),
+        .start(pool_start),
+        .src(pool_desc[POOL_SRC]),
+        .dst(pool_desc[POOL_DST]),
+        .height(pool_desc[POOL_HEIGHT][15:0]),
+        .width(pool_desc[POOL_WIDTH][15:0]),
+        .channels(pool_desc[POOL_CHANNELS][15:0]),
+        .window(pool_desc[POOL_MODE][3:0]),
+        .stride(pool_desc[POOL_MODE][11:8]),
+        .avg(pool_desc[POOL_MODE][16]),
+        .busy(pool_busy),
+        .done(pool_done),
+        .spad_addr(pool_spad_addr),
+        .spad_rdata(scratch[pool_spad_addr]),
+        .spad_we(pool_spad_we),
+        .spad_wdata(pool_spad_wdata)
+    );
+
+    norm_unit #(
+        .SPAD_ADDR_WIDTH(SPAD_ADDR_WIDTH)
+    ) norm_inst (
+        .clk(clk),
+        .rst_n(rst_n & ~accel_reset),
+        .start(norm_start),
+        .src(norm_desc[NORM_SRC]),
+        .dst(norm_desc[NORM_DST]),
+        .params(norm_desc[NORM_PARAMS]),
+        .rows(norm_desc[NORM_ROWS][15:0]),
+        .len(norm_desc[NORM_LEN][15:0]),
+        .inv_len(norm_desc[NORM_INV_LEN]),
+        .eps(norm_desc[NORM_EPS]),
+        .rms(norm_desc[NORM_MODE][0]),
+        .busy(norm_busy),
+        .done(norm_done),
+        .spad_raddr(norm_spad_raddr),
+        .spad_rdata(scratch[norm_spad_raddr]),
+        .param_addr(norm_param_addr),
+        .param_rdata(scratch[norm_param_addr]),
+        .spad_waddr(norm_spad_waddr),
+        .spad_we(norm_spad_we),
+        .spad_wdata(norm_spad_wdata)
+    );
+
+    softmax_unit #(
+        .ACC_WIDTH(ACC_WIDTH),
+        .M(M),
+        .P(P)
+    ) softmax_inst (
+        .clk(clk),
+        .rst_n(rst_n & ~accel_reset),
+        .start(softmax_start),
+        .shift(softmax_shift),
+        .busy(softmax_busy),
+        .done(softmax_done),
+        .c_addr(softmax_c_addr),
+        .c_rdata(matrix_c[softmax_c_addr]),
+        .c_we(softmax_c_we),
+        .c_wdata(softmax_c_wdata)
+    );
+
+    spmv_csr #(
+        .DATA_WIDTH(DATA_WIDTH),
+        .ACC_WIDTH(ACC_WIDTH)
+    ) spmv_inst (
+        .clk(clk),
+        .rst_n(rst_n & ~accel_reset),
+        .start(spmv_start),
+        .rows(spmv_desc[SPMV_ROWS][15:0]),
+        .row_ptr(spmv_desc[SPMV_ROW_PTR]),
+        .col_idx(spmv_desc[SPMV_COL_IDX]),
+        .values(spmv_desc[SPMV_VALUES]),
+        .x_base(spmv_desc[SPMV_X]),
+        .y_base(spmv_desc[SPMV_Y]),
+        .busy(spmv_busy),
+        .done(spmv_done),
+        .ram_valid(spmv_ram_valid),
+        .ram_ready(ram_ready),
+        .ram_addr(spmv_ram_addr),
+        .ram_wdata(spmv_ram_wdata),
+        .ram_wstrb(spmv_ram_wstrb),
+        .ram_rdata(ram_rdata)
+    );
+
     // Matrix multiplication accelerator instance
     matrix_mult #(
         .DATA_WIDTH(DATA_WIDTH),
         .ACC_WIDTH(ACC_WIDTH),
         .M(M),
         .N(N),
-        .P(P)
+        .P(P),
+        .COMPLEX(1)
     ) matrix_mult_inst (
         .clk(clk),
         .rst_n(rst_n & ~accel_reset),
         .start(accel_start),
+        .row_mode(accel_row_mode),
+        .start_row(accel_start_row),
+        .accumulate(accel_accumulate),
+        .cmode(complex_en),
+        .pe_op(pe_op),
+        .gf_poly(gf_poly),
         .done(accel_done),
+        .ready(accel_ready),
+        .busy(accel_busy),
+        .row_valid(accel_row_valid),
+        .bram_a_re(bram_a_re),
+        .bram_b_re(bram_b_re),
+        .bram_wait(bram_wait),
         .bram_a_addr(bram_a_addr),
         .bram_a_rdata(bram_a_rdata),
         .bram_b_addr(bram_b_addr),
         .bram_b_rdata(bram_b_rdata),
         .bram_c_addr(bram_c_addr),
+        .bram_c_rdata(bram_c_rdata),
         .bram_c_we(bram_c_we),
-        .bram_c_wdata(bram_c_wdata)
+        .bram_c_wdata(bram_c_wdata),
+        .bram_ai_rdata(matrix_ai[bram_a_addr]),
+        .bram_bi_rdata(matrix_bi[bram_b_addr]),
+        .bram_a_row(bram_a_row),
+        .bram_b_col(bram_b_col),
+        .bram_ci_rdata(matrix_ci[bram_c_addr]),
+        .bram_ci_wdata(bram_ci_wdata)
     );
 
 endmodule 
\ No newline at end of file
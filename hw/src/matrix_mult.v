@@ -5,13 +5,30 @@ module matrix_mult #(
     parameter ACC_WIDTH = 32,
     parameter M = 4, // Rows of A and C
     parameter N = 4, // Cols of A and Rows of B
-    parameter P = 4  // Cols of B and C
+    parameter P = 4, // Cols of B and C
+    parameter COMPLEX = 0 // Build the complex PE; imaginary parts use the *i ports
 )(
     input clk,
     input rst_n,
 
     input start,
-    output reg done,
+    input row_mode,                   // Job computes only C row start_row
+    input [$clog2(M)-1:0] start_row,
+    input accumulate,                 // Job adds onto the existing C values
+    input cmode,                      // Job multiplies complex operands (COMPLEX builds)
+    input [2:0] pe_op,                // PE operation of the job (see pe.v)
+    input [7:0] gf_poly,              // GF(2^8) reduction polynomial, low byte
+    output done,   // One-cycle pulse per job, coincides with the last C write
+    output ready,  // start is accepted this cycle
+    output busy,
+    output reg [M-1:0] row_valid, // C rows of the current job already written
+
+    // Operand/result memory handshake: the A read (bram_a_re), B read
+    // (bram_b_re) or C write requested this cycle did not complete and must
+    // be repeated. Tie low for buffers that always answer in the same cycle.
+    output bram_a_re,
+    output bram_b_re,
+    input  bram_wait,
 
     // Matrix A BRAM interface
     output reg [$clog2(M*N)-1:0] bram_a_addr,
@@ -23,21 +40,31 @@ module matrix_mult #(
 
     // Matrix C BRAM interface
     output reg [$clog2(M*P)-1:0] bram_c_addr,
+    input [ACC_WIDTH-1:0] bram_c_rdata,
     output reg bram_c_we,
-    output reg [ACC_WIDTH-1:0] bram_c_wdata
+    output reg [ACC_WIDTH-1:0] bram_c_wdata,
+
+    // Imaginary parts, at the same addresses as the real ones
+    input [DATA_WIDTH-1:0] bram_ai_rdata,
+    input [DATA_WIDTH-1:0] bram_bi_rdata,
+    input [ACC_WIDTH-1:0] bram_ci_rdata,
+    output reg [ACC_WIDTH-1:0] bram_ci_wdata,
+
+    // XNOR-popcount jobs read all N elements of an A row and a B column at
+    // once, from bram_a_addr/bram_b_addr upwards (lowest address in the low
+    // byte), and run one PE step per C element
+    input [N*DATA_WIDTH-1:0] bram_a_row,
+    input [N*DATA_WIDTH-1:0] bram_b_col
 );
 
     // FSM states
-    localparam IDLE = 4'd0;
-    localparam FETCH_A = 4'd1;
-    localparam WAIT_A = 4'd2;
-    localparam FETCH_B = 4'd3;
-    localparam COMPUTE = 4'd4;
-    localparam WRITE_C = 4'd5;
-    localparam UPDATE_IJ = 4'd6;
-    localparam FINISH = 4'd7;
+    localparam IDLE = 3'd0;
+    localparam FETCH_A = 3'd1;
+    localparam WAIT_A = 3'd2;
+    localparam FETCH_B = 3'd3;
+    localparam COMPUTE = 3'd4;
 
-    reg [3:0] state, next_state;
+    reg [2:0] state, next_state;
 
     // Loop counters
     reg [$clog2(M)-1:0] i; // for C rows
@@ -46,27 +73,106 @@ module matrix_mult #(
 
     // PE instance
     wire [ACC_WIDTH-1:0] pe_out_d;
+    wire [ACC_WIDTH-1:0] pe_out_di;
     wire                 pe_out_valid;
     reg  [DATA_WIDTH-1:0] pe_in_a;
     reg  [DATA_WIDTH-1:0] pe_in_b;
     reg  [ACC_WIDTH-1:0]  pe_in_c;
+    reg  [DATA_WIDTH-1:0] pe_in_ai;
+    reg  [DATA_WIDTH-1:0] pe_in_bi;
+    reg  [N*DATA_WIDTH-1:0] pe_in_abin;
+    reg  [N*DATA_WIDTH-1:0] pe_in_bbin;
+    reg  [ACC_WIDTH-1:0]  pe_in_ci;
     reg                  pe_in_valid;
 
+    // PE operations whose additive identity is not zero (see pe.v)
+    localparam OP_MINPLUS = 3'd2;
+    localparam OP_MAXPLUS = 3'd3;
+    localparam OP_XNOR    = 3'd5;
+
+    reg  [2:0]           op_job;
+    reg                  cplx_job;
+    wire [ACC_WIDTH-1:0] re_out_d;
+    wire                 re_out_valid;
+
     pe #(
         .DATA_WIDTH(DATA_WIDTH),
-        .ACC_WIDTH(ACC_WIDTH)
+        .ACC_WIDTH(ACC_WIDTH),
+        .BIN_WIDTH(N*DATA_WIDTH)
     ) pe_inst (
         .clk(clk),
         .rst_n(rst_n),
         .in_a(pe_in_a),
         .in_b(pe_in_b),
         .in_c(pe_in_c),
-        .in_valid(pe_in_valid),
-        .out_d(pe_out_d),
-        .out_valid(pe_out_valid)
+        .in_valid(pe_in_valid && !cplx_job),
+        .op(op_job),
+        .gf_poly(gf_poly),
+        .in_abin(pe_in_abin),
+        .in_bbin(pe_in_bbin),
+        .out_d(re_out_d),
+        .out_valid(re_out_valid)
     );
+
+    // Complex jobs run on the complex PE instead
+    generate
+        if (COMPLEX) begin : g_cpe
+            wire [ACC_WIDTH-1:0] cpe_out_d;
+            wire                 cpe_out_valid;
+
+            cpe #(
+                .DATA_WIDTH(DATA_WIDTH),
+                .ACC_WIDTH(ACC_WIDTH)
+            ) cpe_inst (
+                .clk(clk),
+                .rst_n(rst_n),
+                .in_ar(pe_in_a),
+                .in_ai(pe_in_ai),
+                .in_br(pe_in_b),
+                .in_bi(pe_in_bi),
+                .in_cr(pe_in_c),
+                .in_ci(pe_in_ci),
+                .in_valid(pe_in_valid && cplx_job),
+                .out_dr(cpe_out_d),
+                .out_di(pe_out_di),
+                .out_valid(cpe_out_valid)
+            );
+            assign pe_out_d = cplx_job ? cpe_out_d : re_out_d;
+            assign pe_out_valid = re_out_valid || cpe_out_valid;
+        end else begin : g_pe
+            assign pe_out_d = re_out_d;
+            assign pe_out_di = {ACC_WIDTH{1'b0}};
+            assign pe_out_valid = re_out_valid;
+        end
+    endgenerate
     
     reg [ACC_WIDTH-1:0] accum_reg;
+    reg [ACC_WIDTH-1:0] accum_i_reg;
+    reg                 single_row;
+    reg                 acc_job;
+    reg                 out_pending;  // PE result held across a stalled C write
+
+    wire pe_done = pe_out_valid || out_pending;
+
+    // Accumulator start value: the semiring's additive identity
+    wire [ACC_WIDTH-1:0] acc_init =
+        (op_job == OP_MINPLUS) ? {1'b0, {(ACC_WIDTH-1){1'b1}}} :
+        (op_job == OP_MAXPLUS) ? {1'b1, {(ACC_WIDTH-1){1'b0}}} : {ACC_WIDTH{1'b0}};
+
+    // The final MAC of an element writes C straight from the PE output, and
+    // the final element of a job can hand over to the next job in the same
+    // cycle, so back-to-back jobs see no IDLE/FINISH bubbles.
+    wire last_elem = (single_row || i == M-1) && (j == P-1);
+    wire last_k    = (k == N-1) || (op_job == OP_XNOR);
+    wire write_c   = (state == COMPUTE) && pe_done && last_k;
+    wire write_ok  = write_c && !bram_wait;
+    wire last_write = write_ok && last_elem;
+
+    assign done  = last_write;
+    assign ready = (state == IDLE) || last_write;
+    assign busy  = (state != IDLE);
+    assign bram_a_re = (state == WAIT_A);
+    assign bram_b_re = (state == FETCH_B);
 
     // FSM logic
     always @(posedge clk or negedge rst_n) begin
@@ -76,28 +182,43 @@ module matrix_mult #(
             j <= 0;
             k <= 0;
             accum_reg <= 0;
-            done <= 0;
-            bram_a_addr <= 0;
-            bram_b_addr <= 0;
-            bram_c_addr <= 0;
-            bram_c_we <= 0;
-            bram_c_wdata <= 0;
+            accum_i_reg <= 0;
             pe_in_valid <= 0;
+            row_valid <= 0;
+            cplx_job <= 0;
+            op_job <= 0;
+            single_row <= 0;
+            acc_job <= 0;
+            out_pending <= 0;
         end else begin
             state <= next_state;
 
             // Default assignments
             pe_in_valid <= 0;
-            bram_c_we <= 0;
+
+            // Row i is final once its last column is written; a new job
+            // invalidates the rows it will produce, including one finishing
+            // this cycle
+            if (write_ok && j == P-1) begin
+                row_valid[i] <= 1'b1;
+            end
+            if (start && ready) begin
+                if (row_mode) row_valid[start_row] <= 1'b0;
+                else row_valid <= 0;
+                single_row <= row_mode;
+                acc_job <= accumulate;
+                cplx_job <= cmode && (COMPLEX != 0);
+                op_job <= pe_op;
+            end
 
             case(state)
                 IDLE: begin
                     if (start) begin
-                        i <= 0;
+                        i <= row_mode ? start_row : 0;
                         j <= 0;
                         k <= 0;
                         accum_reg <= 0;
-                        done <= 0;
+                        accum_i_reg <= 0;
                     end
                 end
                 FETCH_A: begin
@@ -105,39 +226,47 @@ module matrix_mult #(
                 end
                 WAIT_A: begin
                     pe_in_a <= bram_a_rdata;
+                    pe_in_ai <= cplx_job ? bram_ai_rdata : 0;
+                    pe_in_abin <= bram_a_row;
                 end
                 FETCH_B: begin
                     pe_in_b <= bram_b_rdata;
-                    pe_in_c <= (k == 0) ? 0 : accum_reg;
-                    pe_in_valid <= 1;
+                    pe_in_c <= (k != 0) ? accum_reg :
+                               acc_job ? bram_c_rdata : acc_init;
+                    pe_in_bi <= cplx_job ? bram_bi_rdata : 0;
+                    pe_in_bbin <= bram_b_col;
+                    pe_in_ci <= !cplx_job ? 0 :
+                                (k != 0) ? accum_i_reg :
+                                acc_job ? bram_ci_rdata : 0;
+                    pe_in_valid <= !bram_wait;
                 end
                 COMPUTE: begin
-                    if(pe_out_valid) begin
+                    // The PE output register keeps its value, so a stalled
+                    // C write only has to remember that it is still owed
+                    out_pending <= write_c && bram_wait;
+                    if (pe_done && !(write_c && bram_wait)) begin
                         accum_reg <= pe_out_d;
-                        if (k < N-1) begin
+                        accum_i_reg <= pe_out_di;
+                        if (!last_k) begin
                             k <= k + 1;
+                        end else begin
+                            // C[i,j] is written this cycle; advance to the
+                            // next element or wrap for a restarted job
+                            k <= 0;
+                            accum_reg <= 0;
+                            accum_i_reg <= 0;
+                            if (last_elem) begin
+                                i <= (start && row_mode) ? start_row : 0;
+                                j <= 0;
+                            end else if (j == P-1) begin
+                                i <= i + 1;
+                                j <= 0;
+                            end else begin
+                                j <= j + 1;
+                            end
                         end
                     end
                 end
-                WRITE_C: begin
-                    bram_c_we <= 1;
-                    bram_c_wdata <= accum_reg;
-                end
-                UPDATE_IJ: begin
-                    k <= 0;
-                    accum_reg <= 0;
-                    if (i == M-1 && j == P-1) begin
-                        // done will be set in FINISH state
-                    end else if (j == P-1) begin
-                        i <= i + 1;
-                        j <= 0;
-                    end else begin
-                        j <= j + 1;
-                    end
-                end
-                FINISH: begin
-                   done <= 1;
-                end
             endcase
         end
     end
@@ -151,29 +280,19 @@ module matrix_mult #(
             FETCH_A:
                 next_state = WAIT_A;
             WAIT_A:
-                next_state = FETCH_B;
+                if (!bram_wait) next_state = FETCH_B;
             FETCH_B:
-                next_state = COMPUTE;
+                if (!bram_wait) next_state = COMPUTE;
             COMPUTE:
-                if (pe_out_valid) begin
-                    if (k == N-1) begin
-                        next_state = WRITE_C;
+                if (pe_done && !(write_c && bram_wait)) begin
+                    if (last_write && !start) begin
+                        next_state = IDLE;
                     end else begin
                         next_state = FETCH_A;
                     end
                 end
-            WRITE_C: begin
-                next_state = UPDATE_IJ;
-            end
-            UPDATE_IJ: begin
-                if (i == M-1 && j == P-1) begin
-                    next_state = FINISH;
-                end else begin
-                    next_state = FETCH_A;
-                end
-            end
-            FINISH:
-                if(!start) next_state = IDLE;
+            default:
+                next_state = IDLE;
         endcase
     end
     
@@ -185,6 +304,10 @@ module matrix_mult #(
         bram_b_addr = j * N + k;
         // C is stored row-major. C[i,j]
         bram_c_addr = i * P + j;
+        bram_c_we = write_c;
+        bram_c_wdata = pe_out_d;
+        // Real jobs leave a zero imaginary part, not the cpe's last output
+        bram_ci_wdata = cplx_job ? pe_out_di : {ACC_WIDTH{1'b0}};
     end
 
-endmodule 
\ No newline at end of file
+endmodule
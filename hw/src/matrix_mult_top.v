@@ -73,14 +73,30 @@ module matrix_mult_top #(
         .clk(clk),
         .rst_n(rst_n),
         .start(start),
+        .row_mode(1'b0),
+        .start_row({$clog2(M){1'b0}}),
+        .accumulate(1'b0),
+        .cmode(1'b0),
+        .pe_op(3'd0),
+        .gf_poly(8'h0),
         .done(done),
+        .bram_a_re(),
+        .bram_b_re(),
+        .bram_wait(1'b0),
         .bram_a_addr(bram_a_addr),
         .bram_a_rdata(bram_a_rdata),
         .bram_b_addr(bram_b_addr),
         .bram_b_rdata(bram_b_rdata),
         .bram_c_addr(bram_c_addr),
+        .bram_c_rdata({ACC_WIDTH{1'b0}}),
         .bram_c_we(bram_c_we),
-        .bram_c_wdata(bram_c_wdata)
+        .bram_c_wdata(bram_c_wdata),
+        .bram_ai_rdata({DATA_WIDTH{1'b0}}),
+        .bram_bi_rdata({DATA_WIDTH{1'b0}}),
+        .bram_a_row({N*DATA_WIDTH{1'b0}}),
+        .bram_b_col({N*DATA_WIDTH{1'b0}}),
+        .bram_ci_rdata({ACC_WIDTH{1'b0}}),
+        .bram_ci_wdata()
     );
 
 endmodule 
\ No newline at end of file
@@ -1,8 +1,20 @@
 `timescale 1ns / 1ps
 
+// Processing element: d = c + a * b over the semiring selected by op.
+//   OP_MAC     - integer multiply-add
+//   OP_GF      - GF(2^8): the product is taken modulo the field polynomial
+//                (x^8 + gf_poly) and accumulated with XOR into the low byte
+//   OP_MINPLUS - d = min(c, a + b)   (shortest paths)
+//   OP_MAXPLUS - d = max(c, a + b)   (Viterbi)
+//   OP_BOOL    - d = c | (a & b), bitwise on the low byte (reachability)
+//   OP_XNOR    - d = c + 2 * popcount(~(abin ^ bbin)) - BIN_WIDTH: a dot
+//                product of BIN_WIDTH +/-1 values packed one per bit
+//   OP_L1      - d = c + |a - b|
+//   OP_L2      - d = c + (a - b)^2
 module pe #(
     parameter DATA_WIDTH = 8,
-    parameter ACC_WIDTH = 32
+    parameter ACC_WIDTH = 32,
+    parameter BIN_WIDTH = 32
 ) (
     input clk,
     input rst_n,
@@ -11,11 +23,25 @@ module pe #(
     input signed [DATA_WIDTH-1:0] in_b,
     input signed [ACC_WIDTH-1:0]  in_c,
     input                         in_valid,
+    input [2:0]                   op,
+    input [7:0]                   gf_poly,
+    input [BIN_WIDTH-1:0]         in_abin,   // Packed binary operands (OP_XNOR)
+    input [BIN_WIDTH-1:0]         in_bbin,
 
     output signed [ACC_WIDTH-1:0] out_d,
     output                        out_valid
 );
 
+    // Operations
+    localparam OP_MAC = 3'd0;
+    localparam OP_GF  = 3'd1;
+    localparam OP_MINPLUS = 3'd2;
+    localparam OP_MAXPLUS = 3'd3;
+    localparam OP_BOOL    = 3'd4;
+    localparam OP_XNOR    = 3'd5;
+    localparam OP_L1      = 3'd6;
+    localparam OP_L2      = 3'd7;
+
     reg signed [ACC_WIDTH-1:0] d_reg;
     reg                        valid_reg;
 
@@ -23,13 +49,61 @@ module pe #(
 
     assign mult_res = in_a * in_b;
 
+    wire signed [ACC_WIDTH-1:0] sum_res = in_a + in_b;
+
+    // Distance terms
+    wire signed [DATA_WIDTH:0]     diff     = in_a - in_b;
+    wire signed [ACC_WIDTH-1:0]    abs_diff = (diff < 0) ? -diff : diff;
+    wire signed [2*DATA_WIDTH+1:0] sq_diff  = diff * diff;
+
+    // Shift-and-add GF(2^8) multiply
+    function [7:0] gf_mul;
+        input [7:0] a;
+        input [7:0] b;
+        input [7:0] poly;
+        integer n;
+        reg [7:0] x;
+        begin
+            gf_mul = 8'h0;
+            x = a;
+            for (n = 0; n < 8; n = n + 1) begin
+                if (b[n]) gf_mul = gf_mul ^ x;
+                x = x[7] ? ((x << 1) ^ poly) : (x << 1);
+            end
+        end
+    endfunction
+
+    wire [7:0] gf_res = gf_mul(in_a[7:0], in_b[7:0], gf_poly);
+
+    function [ACC_WIDTH-1:0] popcount;
+        input [BIN_WIDTH-1:0] bits;
+        integer n;
+        begin
+            popcount = 0;
+            for (n = 0; n < BIN_WIDTH; n = n + 1)
+                popcount = popcount + bits[n];
+        end
+    endfunction
+
+    // Matching bits count +1, differing bits -1
+    wire signed [ACC_WIDTH-1:0] xnor_res = (popcount(~(in_abin ^ in_bbin)) << 1) - BIN_WIDTH;
+
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             d_reg <= 0;
             valid_reg <= 0;
         end else begin
             if (in_valid) begin
-                d_reg <= mult_res + in_c;
+                case (op)
+                    OP_GF:   d_reg <= {{(ACC_WIDTH-8){1'b0}}, in_c[7:0] ^ gf_res};
+                    OP_MINPLUS: d_reg <= (sum_res < in_c) ? sum_res : in_c;
+                    OP_MAXPLUS: d_reg <= (sum_res > in_c) ? sum_res : in_c;
+                    OP_BOOL: d_reg <= in_c | {{(ACC_WIDTH-8){1'b0}}, in_a[7:0] & in_b[7:0]};
+                    OP_XNOR: d_reg <= in_c + xnor_res;
+                    OP_L1:   d_reg <= in_c + abs_diff;
+                    OP_L2:   d_reg <= in_c + sq_diff;
+                    default: d_reg <= mult_res + in_c;
+                endcase
                 valid_reg <= 1'b1;
             end else begin
                 valid_reg <= 1'b0;
@@ -40,4 +114,4 @@ module pe #(
     assign out_d = d_reg;
     assign out_valid = valid_reg;
 
-endmodule 
\ No newline at end of file
+endmodule
@@ -0,0 +1,140 @@
+`timescale 1ns / 1ps
+
+// Max/average pooling over a 32-bit feature map in the scratchpad. The map
+// is height x width x channels with channels innermost (a single-channel
+// map is plain row-major); the pooled map is written in the same layout
+// at dst. Windows are window x window (2 or 3) at the given stride, valid
+// positions only. Averages truncate toward zero like C division and are
+// computed with a multiply by the reciprocal of the window area.
+// One input element is read per cycle and each result takes one more
+// cycle to write.
+module pool_unit #(
+    parameter SPAD_ADDR_WIDTH = 10
+)(
+    input clk,
+    input rst_n,
+
+    input         start,
+    input  [31:0] src,        // Scratchpad byte offsets
+    input  [31:0] dst,
+    input  [15:0] height,
+    input  [15:0] width,
+    input  [15:0] channels,
+    input  [3:0]  window,
+    input  [3:0]  stride,
+    input         avg,        // 0 = max, 1 = average
+    output        busy,
+    output reg    done,
+
+    // Scratchpad port (combinational read)
+    output [SPAD_ADDR_WIDTH-1:0] spad_addr,
+    input  [31:0]                spad_rdata,
+    output                       spad_we,
+    output [31:0]                spad_wdata
+);
+
+    // FSM states
+    localparam IDLE  = 2'd0;
+    localparam READ  = 2'd1;
+    localparam WRITE = 2'd2;
+
+    // ceil(2^33 / area): exact quotients for every 32-bit magnitude
+    localparam [31:0] RECIP_4 = 32'd2147483648;
+    localparam [31:0] RECIP_9 = 32'd954437177;
+
+    reg [1:0]  state;
+    reg [15:0] iy0, ix0;      // Top-left input position of the window
+    reg [15:0] c;
+    reg [3:0]  wy, wx;
+    reg [SPAD_ADDR_WIDTH-1:0] out_ptr;
+    reg signed [31:0] acc;
+
+    wire last_wx = (wx == window - 1);
+    wire last_wy = (wy == window - 1);
+    wire last_c  = (c == channels - 1);
+    wire last_x  = (ix0 + stride + window > width);
+    wire last_y  = (iy0 + stride + window > height);
+
+    wire [31:0] in_index = ((iy0 + wy) * width + ix0 + wx) * channels + c;
+    wire signed [31:0] value = spad_rdata;
+    wire signed [31:0] acc_next = (wy == 0 && wx == 0) ? value :
+                                  avg ? acc + value :
+                                  (value > acc) ? value : acc;
+
+    // Average of the window sum in acc
+    wire [31:0] magnitude = acc[31] ? -acc : acc;
+    wire [63:0] scaled    = magnitude * ((window == 3) ? RECIP_9 : RECIP_4);
+    wire [31:0] quotient  = scaled[63:33];
+    wire [31:0] result    = !avg ? acc : acc[31] ? -quotient : quotient;
+
+    assign busy       = (state != IDLE);
+    assign spad_addr  = (state == WRITE) ? out_ptr : src[SPAD_ADDR_WIDTH+1:2] + in_index[SPAD_ADDR_WIDTH-1:0];
+    assign spad_we    = (state == WRITE);
+    assign spad_wdata = result;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            state <= IDLE;
+            iy0 <= 0;
+            ix0 <= 0;
+            c <= 0;
+            wy <= 0;
+            wx <= 0;
+            out_ptr <= 0;
+            acc <= 0;
+            done <= 0;
+        end else begin
+            done <= 0;
+
+            case (state)
+                IDLE: begin
+                    if (start && height >= window && width >= window && channels != 0 && stride != 0) begin
+                        state <= READ;
+                        iy0 <= 0;
+                        ix0 <= 0;
+                        c <= 0;
+                        wy <= 0;
+                        wx <= 0;
+                        out_ptr <= dst[SPAD_ADDR_WIDTH+1:2];
+                    end
+                end
+                READ: begin
+                    acc <= acc_next;
+                    if (last_wx) begin
+                        wx <= 0;
+                        if (last_wy) begin
+                            wy <= 0;
+                            state <= WRITE;
+                        end else begin
+                            wy <= wy + 1;
+                        end
+                    end else begin
+                        wx <= wx + 1;
+                    end
+                end
+                WRITE: begin
+                    out_ptr <= out_ptr + 1;
+                    state <= READ;
+                    if (!last_c) begin
+                        c <= c + 1;
+                    end else begin
+                        c <= 0;
+                        if (!last_x) begin
+                            ix0 <= ix0 + stride;
+                        end else begin
+                            ix0 <= 0;
+                            if (!last_y) begin
+                                iy0 <= iy0 + stride;
+                            end else begin
+                                state <= IDLE;
+                                done <= 1;
+                            end
+                        end
+                    end
+                end
+                default: state <= IDLE;
+            endcase
+        end
+    end
+
+endmodule
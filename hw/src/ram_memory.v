@@ -1,51 +1,117 @@
 `timescale 1ns / 1ps
 
+// Word-interleaved multi-bank RAM with two ports. Consecutive words live in
+// consecutive banks, so the CPU and the accelerator proceed in the same
+// cycle whenever they hit different banks. When both hit the same bank the
+// bank serves one of them and the other sees mem_ready low; priority
+// alternates per bank so neither port can be starved. Each bank counts its
+// conflicts for profiling.
 module ram_memory #(
     parameter SIZE_BYTES = 16384,
-    parameter BASE_ADDR = 32'h00010000
+    parameter BASE_ADDR = 32'h00010000,
+    parameter NUM_BANKS = 4             // Power of two, at least 2
 )(
     input clk,
     input rst_n,
-    
+
     input         mem_valid,
     output        mem_ready,
     input  [31:0] mem_addr,
     input  [31:0] mem_wdata,
     input  [3:0]  mem_wstrb,
-    output [31:0] mem_rdata
+    output [31:0] mem_rdata,
+
+    // Second port for the accelerator (same timing as the CPU port)
+    input         acc_mem_valid,
+    output        acc_mem_ready,
+    input  [31:0] acc_mem_addr,
+    input  [31:0] acc_mem_wdata,
+    input  [3:0]  acc_mem_wstrb,
+    output [31:0] acc_mem_rdata,
+
+    // Per-bank conflict counters
+    input                        clear_conflicts,
+    output [NUM_BANKS*32-1:0]    conflict_counts
 );
 
     localparam SIZE_WORDS = SIZE_BYTES / 4;
     localparam ADDR_BITS = $clog2(SIZE_WORDS);
-
-    // RAM storage
-    reg [31:0] ram_data [0:SIZE_WORDS-1];
+    localparam BANK_BITS = $clog2(NUM_BANKS);
+    localparam BANK_WORDS = SIZE_WORDS / NUM_BANKS;
 
     // Address calculation
     wire [ADDR_BITS-1:0] word_addr = (mem_addr - BASE_ADDR) >> 2;
-    
-    // RAM is always ready (1 cycle latency)
-    assign mem_ready = mem_valid;
-    
+    wire [ADDR_BITS-1:0] acc_word_addr = (acc_mem_addr - BASE_ADDR) >> 2;
+    wire [BANK_BITS-1:0] cpu_bank = word_addr[BANK_BITS-1:0];
+    wire [BANK_BITS-1:0] acc_bank = acc_word_addr[BANK_BITS-1:0];
+
+    // Bank arbitration: acc_first[b] says who wins the next conflict on b
+    reg  [NUM_BANKS-1:0] acc_first;
+    wire conflict = mem_valid && acc_mem_valid && (cpu_bank == acc_bank);
+    wire acc_wins = acc_first[acc_bank];
+
+    // Banks answer in the same cycle unless the other port owns them
+    assign mem_ready = mem_valid && !(conflict && acc_wins);
+    assign acc_mem_ready = acc_mem_valid && !(conflict && !acc_wins);
+
+    wire cpu_go = mem_ready;
+    wire acc_go = acc_mem_ready;
+
+    wire [NUM_BANKS*32-1:0] bank_rdata;
+    reg  [31:0] conflicts [0:NUM_BANKS-1];
+
     // Read logic
-    assign mem_rdata = mem_valid ? ram_data[word_addr] : 32'h0;
+    assign mem_rdata = mem_valid ? bank_rdata[cpu_bank*32 +: 32] : 32'h0;
+    assign acc_mem_rdata = acc_mem_valid ? bank_rdata[acc_bank*32 +: 32] : 32'h0;
 
-    // Write logic with byte enables
+    integer n;
     always @(posedge clk) begin
-        if (mem_valid && |mem_wstrb) begin
-            if (mem_wstrb[0]) ram_data[word_addr][7:0]   <= mem_wdata[7:0];
-            if (mem_wstrb[1]) ram_data[word_addr][15:8]  <= mem_wdata[15:8];
-            if (mem_wstrb[2]) ram_data[word_addr][23:16] <= mem_wdata[23:16];
-            if (mem_wstrb[3]) ram_data[word_addr][31:24] <= mem_wdata[31:24];
+        if (!rst_n || clear_conflicts) begin
+            for (n = 0; n < NUM_BANKS; n = n + 1) conflicts[n] <= 32'h0;
+        end else if (conflict) begin
+            conflicts[cpu_bank] <= conflicts[cpu_bank] + 1;
         end
-    end
 
-    // Initialize RAM to known values for debugging
-    integer i;
-    initial begin
-        for (i = 0; i < SIZE_WORDS; i = i + 1) begin
-            ram_data[i] = 32'h00000000;
+        if (!rst_n) begin
+            acc_first <= {NUM_BANKS{1'b0}};
+        end else if (conflict) begin
+            // The loser goes first next time
+            acc_first[cpu_bank] <= !acc_wins;
         end
     end
 
-endmodule 
\ No newline at end of file
+    genvar b;
+    generate
+        for (b = 0; b < NUM_BANKS; b = b + 1) begin : bank
+            // RAM storage
+            reg [31:0] ram_data [0:BANK_WORDS-1];
+
+            wire acc_sel = acc_go && (acc_bank == b);
+            wire cpu_sel = cpu_go && (cpu_bank == b);
+            wire [ADDR_BITS-BANK_BITS-1:0] addr =
+                acc_sel ? acc_word_addr[ADDR_BITS-1:BANK_BITS] : word_addr[ADDR_BITS-1:BANK_BITS];
+            wire [31:0] wdata = acc_sel ? acc_mem_wdata : mem_wdata;
+            wire [3:0]  wstrb = acc_sel ? acc_mem_wstrb : cpu_sel ? mem_wstrb : 4'h0;
+
+            assign bank_rdata[b*32 +: 32] = ram_data[addr];
+            assign conflict_counts[b*32 +: 32] = conflicts[b];
+
+            // Write logic with byte enables
+            always @(posedge clk) begin
+                if (wstrb[0]) ram_data[addr][7:0]   <= wdata[7:0];
+                if (wstrb[1]) ram_data[addr][15:8]  <= wdata[15:8];
+                if (wstrb[2]) ram_data[addr][23:16] <= wdata[23:16];
+                if (wstrb[3]) ram_data[addr][31:24] <= wdata[31:24];
+            end
+
+            // Initialize RAM to known values for debugging
+            integer i;
+            initial begin
+                for (i = 0; i < BANK_WORDS; i = i + 1) begin
+                    ram_data[i] = 32'h00000000;
+                end
+            end
+        end
+    endgenerate
+
+endmodule
@@ -7,7 +7,8 @@ module riscv_soc #(
     parameter N = 4,
     parameter P = 4,
     parameter ROM_SIZE_BYTES = 16384,  // 16KB ROM
-    parameter RAM_SIZE_BYTES = 16384   // 16KB RAM
+    parameter RAM_SIZE_BYTES = 16384,  // 16KB RAM
+    parameter NUM_ACCEL = 2            // Chainable accelerator units
 )(
     input clk,
     input rst_n,
@@ -23,7 +24,10 @@ module riscv_soc #(
     localparam RAM_BASE = 32'h80004000;  // RAM after ROM
     localparam RAM_TOP  = RAM_BASE + RAM_SIZE_BYTES - 1;
     localparam ACCEL_BASE = 32'h10000000;
-    localparam ACCEL_TOP  = 32'h100003FF;
+    localparam ACCEL_SPAN = 32'h00002000; // 8KB window per unit
+    localparam ACCEL_TOP  = ACCEL_BASE + NUM_ACCEL * ACCEL_SPAN - 1;
+    localparam ACCEL_BCAST_BASE = 32'h10100000; // Multicast window + mask
+    localparam RAM_STATS_BASE = 32'h10200000;   // RAM bank conflict counters
 
     // PicoRV32 memory interface
     wire        cpu_mem_valid;
@@ -71,7 +75,12 @@ module riscv_soc #(
         .RAM_BASE(RAM_BASE),
         .RAM_TOP(RAM_TOP),
         .ACCEL_BASE(ACCEL_BASE),
-        .ACCEL_TOP(ACCEL_TOP)
+        .ACCEL_TOP(ACCEL_TOP),
+        .NUM_ACCEL(NUM_ACCEL),
+        .ACCEL_SPAN(ACCEL_SPAN),
+        .ACCEL_BCAST_BASE(ACCEL_BCAST_BASE),
+        .RAM_BANKS(4),
+        .RAM_STATS_BASE(RAM_STATS_BASE)
     ) interconnect (
         .clk(clk),
         .rst_n(rst_n),
@@ -0,0 +1,201 @@
+`timescale 1ns / 1ps
+
+// Row-wise softmax over the MxP result buffer. For every row the unit finds
+// the maximum, turns each element into exp(-(max - c) / 8) through a
+// 64-entry LUT, with (max - c) first shifted right by `shift` so callers
+// pick the logit scale, sums the row and multiplies each term by a LUT
+// reciprocal of the sum. Results are written back in place as unsigned
+// Q0.7 probabilities (0..127, 1.0 saturates to 127), so they can feed the
+// 8-bit operand buffers directly. Each row takes 3*P cycles.
+module softmax_unit #(
+    parameter ACC_WIDTH = 32,
+    parameter M = 4,
+    parameter P = 4             // At most 4 (row sum fits [2^15, 2^17])
+)(
+    input clk,
+    input rst_n,
+
+    input             start,
+    input      [4:0]  shift,
+    output            busy,
+    output reg        done,
+
+    // Result buffer port (combinational read)
+    output [$clog2(M*P)-1:0] c_addr,
+    input  [ACC_WIDTH-1:0]   c_rdata,
+    output                   c_we,
+    output [ACC_WIDTH-1:0]   c_wdata
+);
+
+    // FSM states
+    localparam IDLE = 2'd0;
+    localparam MAX  = 2'd1;
+    localparam EXP  = 2'd2;
+    localparam NORM = 2'd3;
+
+    reg [1:0] state;
+    reg [$clog2(M)-1:0] i;
+    reg [$clog2(P)-1:0] j;
+    reg signed [ACC_WIDTH-1:0] row_max;
+    reg [17:0] sum;              // Up to 4 terms of at most 1.0 (Q1.15)
+    reg [15:0] terms [0:P-1];
+
+    // exp(-d/8) in Q1.15
+    function [15:0] exp_lut;
+        input [5:0] d;
+        begin
+            case (d)
+                6'd0: exp_lut = 16'd32768;
+                6'd1: exp_lut = 16'd28918;
+                6'd2: exp_lut = 16'd25520;
+                6'd3: exp_lut = 16'd22521;
+                6'd4: exp_lut = 16'd19875;
+                6'd5: exp_lut = 16'd17539;
+                6'd6: exp_lut = 16'd15479;
+                6'd7: exp_lut = 16'd13660;
+                6'd8: exp_lut = 16'd12055;
+                6'd9: exp_lut = 16'd10638;
+                6'd10: exp_lut = 16'd9388;
+                6'd11: exp_lut = 16'd8285;
+                6'd12: exp_lut = 16'd7312;
+                6'd13: exp_lut = 16'd6452;
+                6'd14: exp_lut = 16'd5694;
+                6'd15: exp_lut = 16'd5025;
+                6'd16: exp_lut = 16'd4435;
+                6'd17: exp_lut = 16'd3914;
+                6'd18: exp_lut = 16'd3454;
+                6'd19: exp_lut = 16'd3048;
+                6'd20: exp_lut = 16'd2690;
+                6'd21: exp_lut = 16'd2374;
+                6'd22: exp_lut = 16'd2095;
+                6'd23: exp_lut = 16'd1849;
+                6'd24: exp_lut = 16'd1631;
+                6'd25: exp_lut = 16'd1440;
+                6'd26: exp_lut = 16'd1271;
+                6'd27: exp_lut = 16'd1121;
+                6'd28: exp_lut = 16'd990;
+                6'd29: exp_lut = 16'd873;
+                6'd30: exp_lut = 16'd771;
+                6'd31: exp_lut = 16'd680;
+                6'd32: exp_lut = 16'd600;
+                6'd33: exp_lut = 16'd530;
+                6'd34: exp_lut = 16'd467;
+                6'd35: exp_lut = 16'd412;
+                6'd36: exp_lut = 16'd364;
+                6'd37: exp_lut = 16'd321;
+                6'd38: exp_lut = 16'd283;
+                6'd39: exp_lut = 16'd250;
+                6'd40: exp_lut = 16'd221;
+                6'd41: exp_lut = 16'd195;
+                6'd42: exp_lut = 16'd172;
+                6'd43: exp_lut = 16'd152;
+                6'd44: exp_lut = 16'd134;
+                6'd45: exp_lut = 16'd118;
+                6'd46: exp_lut = 16'd104;
+                6'd47: exp_lut = 16'd92;
+                6'd48: exp_lut = 16'd81;
+                6'd49: exp_lut = 16'd72;
+                6'd50: exp_lut = 16'd63;
+                6'd51: exp_lut = 16'd56;
+                6'd52: exp_lut = 16'd49;
+                6'd53: exp_lut = 16'd43;
+                6'd54: exp_lut = 16'd38;
+                6'd55: exp_lut = 16'd34;
+                6'd56: exp_lut = 16'd30;
+                6'd57: exp_lut = 16'd26;
+                6'd58: exp_lut = 16'd23;
+                6'd59: exp_lut = 16'd21;
+                6'd60: exp_lut = 16'd18;
+                6'd61: exp_lut = 16'd16;
+                6'd62: exp_lut = 16'd14;
+                6'd63: exp_lut = 16'd12;
+                default: exp_lut = 16'd0;
+            endcase
+        end
+    endfunction
+
+    // 2^31 / s for s in [2^16, 2^17), indexed by the 8 bits below the
+    // leading one (midpoint of each bucket, rounded)
+    reg [15:0] recip_lut [0:255];
+    integer n;
+    initial begin
+        for (n = 0; n < 256; n = n + 1)
+            recip_lut[n] = ((64'd1 << 32) / (65536 + n * 256 + 128) + 1) >> 1;
+    end
+
+    wire signed [ACC_WIDTH-1:0] value = c_rdata;
+    wire [ACC_WIDTH-1:0] dist = (row_max - value) >> shift;
+    wire [15:0] term = (dist > 63) ? 16'd0 : exp_lut(dist[5:0]);
+
+    // The row maximum contributes exactly 1.0, so sum >= 2^15; normalize it
+    // into [2^16, 2^17) before the lookup. Only a row of four equal terms
+    // reaches 2^17, which the last entry covers
+    wire        sum_small = !sum[16] && !sum[17];
+    wire [17:0] sum_norm  = sum_small ? (sum << 1) : sum;
+    wire [15:0] recip     = sum[17] ? recip_lut[255] : recip_lut[sum_norm[15:8]];
+    wire [32:0] scaled    = (terms[j] * recip) << sum_small;
+    wire [9:0]  prob      = (scaled + (1 << 23)) >> 24;
+
+    assign busy    = (state != IDLE);
+    assign c_addr  = i * P + j;
+    assign c_we    = (state == NORM);
+    assign c_wdata = (prob > 127) ? 127 : prob;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            state <= IDLE;
+            i <= 0;
+            j <= 0;
+            row_max <= 0;
+            sum <= 0;
+            done <= 0;
+        end else begin
+            done <= 0;
+
+            case (state)
+                IDLE: begin
+                    if (start) begin
+                        state <= MAX;
+                        i <= 0;
+                        j <= 0;
+                    end
+                end
+                MAX: begin
+                    if (j == 0 || value > row_max) row_max <= value;
+                    if (j == P-1) begin
+                        j <= 0;
+                        sum <= 0;
+                        state <= EXP;
+                    end else begin
+                        j <= j + 1;
+                    end
+                end
+                EXP: begin
+                    terms[j] <= term;
+                    sum <= sum + term;
+                    if (j == P-1) begin
+                        j <= 0;
+                        state <= NORM;
+                    end else begin
+                        j <= j + 1;
+                    end
+                end
+                NORM: begin
+                    if (j == P-1) begin
+                        j <= 0;
+                        if (i == M-1) begin
+                            state <= IDLE;
+                            done <= 1;
+                        end else begin
+                            i <= i + 1;
+                            state <= MAX;
+                        end
+                    end else begin
+                        j <= j + 1;
+                    end
+                end
+            endcase
+        end
+    end
+
+endmodule
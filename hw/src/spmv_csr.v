@@ -0,0 +1,169 @@
+`timescale 1ns / 1ps
+
+// Sparse matrix-vector product y = A * x over a CSR matrix in RAM. The unit
+// walks the row pointers, fetches each nonzero's column index and value,
+// gathers the matching x element and accumulates through a PE:
+//   row_ptr[rows+1], col_idx[nnz]: 32-bit words
+//   values[nnz], x[cols]:          DATA_WIDTH-bit signed bytes
+//   y[rows]:                       32-bit results
+// Every RAM access waits for ram_ready, so the port can be shared. Each
+// nonzero costs three reads and each row one pointer read and one write;
+// row_ptr[r+1] is reused as the start of row r+1.
+module spmv_csr #(
+    parameter DATA_WIDTH = 8,
+    parameter ACC_WIDTH = 32
+)(
+    input clk,
+    input rst_n,
+
+    input         start,
+    input  [15:0] rows,
+    input  [31:0] row_ptr,
+    input  [31:0] col_idx,
+    input  [31:0] values,
+    input  [31:0] x_base,
+    input  [31:0] y_base,
+    output        busy,
+    output reg    done,
+
+    // RAM master port (same timing as the CPU port)
+    output        ram_valid,
+    input         ram_ready,
+    output [31:0] ram_addr,
+    output [31:0] ram_wdata,
+    output [3:0]  ram_wstrb,
+    input  [31:0] ram_rdata
+);
+
+    // FSM states
+    localparam IDLE      = 3'd0;
+    localparam PTR_FIRST = 3'd1;  // row_ptr[0]
+    localparam PTR_NEXT  = 3'd2;  // row_ptr[r+1]
+    localparam ROW       = 3'd3;  // Next nonzero or end of row
+    localparam COL       = 3'd4;  // col_idx[e]
+    localparam VAL       = 3'd5;  // values[e]
+    localparam GATHER    = 3'd6;  // x[col], MAC
+    localparam STORE     = 3'd7;  // y[r]
+
+    reg [2:0]  state;
+    reg [15:0] r;
+    reg [31:0] e, e_end;
+    reg [31:0] col;
+    reg [DATA_WIDTH-1:0] val;
+    reg [ACC_WIDTH-1:0]  acc;
+
+    reg [31:0] ram_byte;
+    always @(*) begin
+        case (state)
+            PTR_FIRST: ram_byte = row_ptr;
+            PTR_NEXT:  ram_byte = row_ptr + (r + 1) * 4;
+            COL:       ram_byte = col_idx + e * 4;
+            VAL:       ram_byte = values + e;
+            GATHER:    ram_byte = x_base + col;
+            default:   ram_byte = y_base + r * 4;
+        endcase
+    end
+
+    wire [31:0] ram_shifted = ram_rdata >> (ram_byte[1:0] * 8);
+    wire        granted = ram_valid && ram_ready;
+
+    assign busy      = (state != IDLE);
+    assign ram_valid = (state != IDLE) && (state != ROW);
+    assign ram_addr  = {ram_byte[31:2], 2'b00};
+    assign ram_wdata = acc;
+    assign ram_wstrb = (state == STORE) ? 4'hF : 4'h0;
+
+    // The MAC result lands the cycle after GATHER, in ROW, before acc is
+    // used again
+    wire [ACC_WIDTH-1:0] pe_out_d;
+    wire                 pe_out_valid;
+
+    pe #(
+        .DATA_WIDTH(DATA_WIDTH),
+        .ACC_WIDTH(ACC_WIDTH)
+    ) pe_inst (
+        .clk(clk),
+        .rst_n(rst_n),
+        .in_a(val),
+        .in_b(ram_shifted[DATA_WIDTH-1:0]),
+        .in_c(acc),
+        .in_valid(state == GATHER && granted),
+        .op(3'd0),
+        .gf_poly(8'h0),
+        .in_abin(32'h0),
+        .in_bbin(32'h0),
+        .out_d(pe_out_d),
+        .out_valid(pe_out_valid)
+    );
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            state <= IDLE;
+            r <= 0;
+            e <= 0;
+            e_end <= 0;
+            col <= 0;
+            val <= 0;
+            acc <= 0;
+            done <= 0;
+        end else begin
+            done <= 0;
+            if (pe_out_valid) acc <= pe_out_d;
+
+            case (state)
+                IDLE: begin
+                    if (start && rows != 0) begin
+                        r <= 0;
+                        state <= PTR_FIRST;
+                    end
+                end
+                PTR_FIRST: begin
+                    if (granted) begin
+                        e <= ram_rdata;
+                        state <= PTR_NEXT;
+                    end
+                end
+                PTR_NEXT: begin
+                    if (granted) begin
+                        e_end <= ram_rdata;
+                        acc <= 0;
+                        state <= ROW;
+                    end
+                end
+                ROW: begin
+                    state <= (e == e_end) ? STORE : COL;
+                end
+                COL: begin
+                    if (granted) begin
+                        col <= ram_rdata;
+                        state <= VAL;
+                    end
+                end
+                VAL: begin
+                    if (granted) begin
+                        val <= ram_shifted[DATA_WIDTH-1:0];
+                        state <= GATHER;
+                    end
+                end
+                GATHER: begin
+                    if (granted) begin
+                        e <= e + 1;
+                        state <= ROW;
+                    end
+                end
+                STORE: begin
+                    if (granted) begin
+                        if (r == rows - 1) begin
+                            done <= 1;
+                            state <= IDLE;
+                        end else begin
+                            r <= r + 1;
+                            state <= PTR_NEXT;
+                        end
+                    end
+                end
+            endcase
+        end
+    end
+
+endmodule
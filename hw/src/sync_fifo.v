@@ -0,0 +1,49 @@
+`timescale 1ns / 1ps
+
+module sync_fifo #(
+    parameter WIDTH = 8,
+    parameter DEPTH = 16
+)(
+    input clk,
+    input rst_n,
+
+    input              push,
+    input  [WIDTH-1:0] push_data,
+    input              pop,
+    output [WIDTH-1:0] pop_data,   // Head of the FIFO (first-word fall-through)
+
+    output reg [$clog2(DEPTH+1)-1:0] count,
+    output             full,
+    output             empty
+);
+
+    reg [WIDTH-1:0] mem [0:DEPTH-1];
+    reg [$clog2(DEPTH)-1:0] rd_ptr;
+    reg [$clog2(DEPTH)-1:0] wr_ptr;
+
+    wire do_push = push && !full;
+    wire do_pop  = pop && !empty;
+
+    assign pop_data = mem[rd_ptr];
+    assign full  = (count == DEPTH);
+    assign empty = (count == 0);
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            rd_ptr <= 0;
+            wr_ptr <= 0;
+            count <= 0;
+        end else begin
+            if (do_push) begin
+                mem[wr_ptr] <= push_data;
+                wr_ptr <= (wr_ptr == DEPTH-1) ? 0 : wr_ptr + 1;
+            end
+            if (do_pop) begin
+                rd_ptr <= (rd_ptr == DEPTH-1) ? 0 : rd_ptr + 1;
+            end
+            if (do_push && !do_pop) count <= count + 1;
+            else if (do_pop && !do_push) count <= count - 1;
+        end
+    end
+
+endmodule
@@ -0,0 +1,417 @@
+`timescale 1ns / 1ps
+
+// Executes one tile operation at a time between the accelerator scratchpad
+// and the matrix_mult operand/result buffers:
+//   LOAD_A  - copy an MxN row-major byte tile into the A buffer
+//   LOAD_B  - copy an NxP row-major byte tile into the (column-major) B buffer
+//   GEMM    - run one matrix_mult job and wait for its done pulse
+//             (op_arg[0]: accumulate onto the existing C buffer)
+//   STORE_C - copy the MxP result buffer out as row-major 32-bit words
+//   ELTWISE - rewrite every C element in place (op_arg[1:0]: 0 = ReLU,
+//             1 = arithmetic shift right by op_arg[12:8], 2 = A (.) B,
+//             3 = C + A (.) B; the products need square tiles)
+//   LOAD_A_RLE  - expand a zero-run-length stream into the A buffer
+//   STORE_C_RLE - requantize C to DATA_WIDTH (shift right by op_arg[4:0],
+//                 saturate) and write it out as a zero-run-length stream;
+//                 the stream length in bytes is left in rle_len
+// Moves transfer one element per cycle. For moves op_arg is the byte
+// distance between consecutive tile rows in the scratchpad, and op_rows/
+// op_cols give the valid extent of an edge tile: loads fill pad_data outside
+// it and stores leave the scratchpad untouched there.
+//
+// LOAD_B goes through a small cache: the B buffer holds B_ENTRIES tiles and
+// each is tagged with the source address, row stride, extent and the
+// generation current when it was loaded. A LOAD_B matching a valid tag just
+// selects that entry (b_sel) and completes in one cycle; a miss refills the
+// next entry in round-robin order. Software bumps the generation whenever it
+// rewrites weights in the scratchpad, which retires every older tag.
+//
+// Zero-run-length streams are byte tokens covering a tile in row-major
+// order: 1nnnnnnn is a run of n+1 zeros, 0nnnnnnn is followed by n+1 literal
+// elements. Expansion handles one element per cycle plus one cycle per
+// token; compression writes one byte per cycle.
+module tile_engine #(
+    parameter DATA_WIDTH = 8,
+    parameter ACC_WIDTH = 32,
+    parameter M = 4,
+    parameter N = 4,
+    parameter P = 4,
+    parameter SPAD_ADDR_WIDTH = 10, // Scratchpad word address width
+    parameter B_ENTRIES = 4         // B tile cache entries
+)(
+    input clk,
+    input rst_n,
+
+    // Operation interface
+    input             op_valid,
+    input      [2:0]  op_code,
+    input      [31:0] op_addr,
+    input      [15:0] op_arg,
+    input      [7:0]  op_rows,
+    input      [7:0]  op_cols,
+    output            op_ready,
+    output reg        op_done,
+
+    // Scratchpad port (combinational read)
+    output reg [SPAD_ADDR_WIDTH-1:0] spad_addr,
+    input      [31:0]                spad_rdata,
+    output reg                       spad_we,
+    output reg [3:0]                 spad_wstrb,
+    output reg [31:0]                spad_wdata,
+    output reg [15:0]                rle_len,  // Bytes written by the last STORE_C_RLE
+
+    // Operand buffer write ports
+    output reg                     a_we,
+    output reg [$clog2(M*N)-1:0]   a_addr,
+    output reg [DATA_WIDTH-1:0]    a_wdata,
+    output reg                     b_we,
+    output reg [$clog2(N*P)-1:0]   b_addr,
+    output reg [DATA_WIDTH-1:0]    b_wdata,
+    input      [DATA_WIDTH-1:0]    a_rdata,  // Operand reads at a_addr/b_addr
+    input      [DATA_WIDTH-1:0]    b_rdata,
+    input      [DATA_WIDTH-1:0]    pad_data, // Edge tile fill (0 unless min/max-plus)
+
+    // B tile cache
+    output reg [$clog2(B_ENTRIES)-1:0] b_sel,   // Entry the core and CPU see
+    input      [7:0]                   b_gen,   // Current weight generation
+    input                              b_invalidate, // Selected entry rewritten
+    output reg                         b_hit,   // LOAD_B lookup pulses
+    output reg                         b_miss,
+
+    // Result buffer port (combinational read)
+    output reg [$clog2(M*P)-1:0]   c_addr,
+    input      [ACC_WIDTH-1:0]     c_rdata,
+    output reg                     c_we,
+    output reg [ACC_WIDTH-1:0]     c_wdata,
+
+    // Compute core handshake
+    output            core_start,
+    output            core_accumulate,
+    input             core_accept,
+    input             core_done
+);
+
+    // Operation codes
+    localparam OP_LOAD_A  = 3'd0;
+    localparam OP_LOAD_B  = 3'd1;
+    localparam OP_GEMM    = 3'd2;
+    localparam OP_STORE_C = 3'd3;
+    localparam OP_ELTWISE = 3'd4;
+    localparam OP_LOAD_A_RLE  = 3'd5;
+    localparam OP_STORE_C_RLE = 3'd6;
+
+    // Element-wise functions
+    localparam ELT_RELU = 2'd0;
+    localparam ELT_SRA  = 2'd1;
+    localparam ELT_MUL  = 2'd2;
+    localparam ELT_MAC  = 2'd3;
+
+    // Run-length encoder state
+    localparam RUN_NONE = 2'd0;
+    localparam RUN_ZERO = 2'd1;
+    localparam RUN_LIT  = 2'd2;
+
+    // FSM states
+    localparam IDLE      = 3'd0;
+    localparam MOVE      = 3'd1;
+    localparam GEMM_START = 3'd2;
+    localparam GEMM_WAIT = 3'd3;
+    localparam RLE_LOAD  = 3'd4;
+    localparam RLE_STORE = 3'd5;
+    localparam RLE_FLUSH = 3'd6;
+
+    reg [2:0]  state;
+    reg [2:0]  code;
+    reg [31:0] base;
+    reg [15:0] arg;
+    reg [7:0]  valid_rows, valid_cols;
+    reg [7:0]  r, c;
+
+    // Run-length streams: rle_ptr is the next byte to read or write, tok_ptr
+    // the reserved token of an open literal run
+    reg [31:0] rle_ptr;
+    reg [31:0] tok_ptr;
+    reg [1:0]  run_mode;
+    reg [7:0]  run_count;  // Expander: elements left in the token; encoder: run length
+
+    // B cache tags
+    reg                         tag_valid [0:B_ENTRIES-1];
+    reg [31:0]                  tag_addr  [0:B_ENTRIES-1];
+    reg [15:0]                  tag_ld    [0:B_ENTRIES-1];
+    reg [15:0]                  tag_ext   [0:B_ENTRIES-1];  // {rows, cols}
+    reg [7:0]                   tag_gen   [0:B_ENTRIES-1];
+    reg [$clog2(B_ENTRIES)-1:0] victim;
+
+    reg                         lookup_hit;
+    reg [$clog2(B_ENTRIES)-1:0] lookup_entry;
+    integer e;
+    always @(*) begin
+        lookup_hit = 1'b0;
+        lookup_entry = 0;
+        for (e = 0; e < B_ENTRIES; e = e + 1) begin
+            if (tag_valid[e] && tag_addr[e] == op_addr && tag_ld[e] == op_arg &&
+                tag_ext[e] == {op_rows, op_cols} && tag_gen[e] == b_gen) begin
+                lookup_hit = 1'b1;
+                lookup_entry = e;
+            end
+        end
+    end
+
+    // Tile shape for the current move
+    wire [7:0] rows = (code == OP_LOAD_B) ? N : M;
+    wire [7:0] cols = (code == OP_LOAD_A || code == OP_LOAD_A_RLE) ? N : P;
+    wire last_elem = (r == rows - 1) && (c == cols - 1);
+    wire in_tile   = (r < valid_rows) && (c < valid_cols);
+
+    wire [31:0] byte_addr = base + r * arg + ((code == OP_STORE_C) ? c * 4 : c);
+    wire [31:0] byte_data = spad_rdata >> (byte_addr[1:0] * 8);
+
+    // Element-wise function on the current C element
+    // (A[r][c] and B[r][c] for the products, B being column-major)
+    wire signed [ACC_WIDTH-1:0] c_elem = c_rdata;
+    wire signed [2*DATA_WIDTH-1:0] ab_prod = $signed(a_rdata) * $signed(b_rdata);
+    reg  [ACC_WIDTH-1:0] elt_result;
+    always @(*) begin
+        case (arg[1:0])
+            ELT_RELU: elt_result = c_elem[ACC_WIDTH-1] ? 0 : c_elem;
+            ELT_SRA:  elt_result = c_elem >>> arg[12:8];
+            ELT_MUL:  elt_result = {{(ACC_WIDTH-2*DATA_WIDTH){ab_prod[2*DATA_WIDTH-1]}}, ab_prod};
+            default:  elt_result = c_elem + {{(ACC_WIDTH-2*DATA_WIDTH){ab_prod[2*DATA_WIDTH-1]}}, ab_prod};
+        endcase
+    end
+
+    // Expander: current stream byte
+    wire [31:0] rle_word = spad_rdata >> (rle_ptr[1:0] * 8);
+    wire [7:0]  rle_byte = rle_word[7:0];
+
+    // Encoder: current C element requantized to DATA_WIDTH
+    wire signed [ACC_WIDTH-1:0] c_shifted = c_elem >>> arg[4:0];
+    reg  [DATA_WIDTH-1:0] c_small;
+    always @(*) begin
+        if (c_shifted > $signed((1 << (DATA_WIDTH-1)) - 1))
+            c_small = {1'b0, {(DATA_WIDTH-1){1'b1}}};
+        else if (c_shifted < -$signed(1 << (DATA_WIDTH-1)))
+            c_small = {1'b1, {(DATA_WIDTH-1){1'b0}}};
+        else
+            c_small = c_shifted[DATA_WIDTH-1:0];
+    end
+    wire c_zero = (c_small == 0);
+
+    // An open run is closed (its token written) before the next element
+    // when the element does not extend it or the run is full
+    wire run_close = (state == RLE_FLUSH) ? (run_mode != RUN_NONE) :
+                     (run_mode == RUN_ZERO) ? (!c_zero || run_count == 128) :
+                     (run_mode == RUN_LIT)  ? (c_zero || run_count == 128) : 1'b0;
+
+    // Encoder byte write for this cycle
+    reg        rle_we;
+    reg [31:0] rle_waddr;
+    reg [7:0]  rle_wbyte;
+    always @(*) begin
+        rle_we = 1'b0;
+        rle_waddr = rle_ptr;
+        rle_wbyte = c_small;
+        if (state == RLE_STORE || state == RLE_FLUSH) begin
+            if (run_close) begin
+                rle_we = 1'b1;
+                if (run_mode == RUN_ZERO) begin
+                    rle_wbyte = {1'b1, run_count[6:0] - 7'd1};
+                end else begin
+                    rle_waddr = tok_ptr;
+                    rle_wbyte = {1'b0, run_count[6:0] - 7'd1};
+                end
+            end else if (state == RLE_STORE && !c_zero) begin
+                // A new literal run skips its reserved token byte
+                rle_we = 1'b1;
+                rle_waddr = (run_mode == RUN_NONE) ? rle_ptr + 1 : rle_ptr;
+            end
+        end
+    end
+
+    assign op_ready   = (state == IDLE);
+    assign core_start = (state == GEMM_START);
+    assign core_accumulate = arg[0];
+
+    always @(*) begin
+        spad_addr  = byte_addr[SPAD_ADDR_WIDTH+1:2];
+        spad_we    = (state == MOVE) && (code == OP_STORE_C) && in_tile;
+        spad_wstrb = 4'hF;
+        spad_wdata = c_rdata;
+        if (state == RLE_LOAD) begin
+            spad_addr = rle_ptr[SPAD_ADDR_WIDTH+1:2];
+        end else if (state == RLE_STORE || state == RLE_FLUSH) begin
+            spad_addr  = rle_waddr[SPAD_ADDR_WIDTH+1:2];
+            spad_we    = rle_we;
+            spad_wstrb = 4'b0001 << rle_waddr[1:0];
+            spad_wdata = {4{rle_wbyte}};
+        end
+
+        a_we    = (state == MOVE) && (code == OP_LOAD_A);
+        a_addr  = r * N + c;
+        a_wdata = in_tile ? byte_data[DATA_WIDTH-1:0] : pad_data;
+        if (state == RLE_LOAD) begin
+            // Token bytes (run_count == 0) produce no element
+            a_we    = (run_count != 0);
+            a_wdata = run_mode == RUN_ZERO ? 0 : rle_byte[DATA_WIDTH-1:0];
+        end
+
+        // B buffer is column-major: B[k,j] lives at j*N + k
+        b_we    = (state == MOVE) && (code == OP_LOAD_B);
+        b_addr  = c * N + r;
+        b_wdata = in_tile ? byte_data[DATA_WIDTH-1:0] : pad_data;
+
+        c_addr  = r * P + c;
+        c_we    = (state == MOVE) && (code == OP_ELTWISE);
+        c_wdata = elt_result;
+    end
+
+    integer t;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            state <= IDLE;
+            code <= 0;
+            base <= 0;
+            arg <= 0;
+            valid_rows <= 0;
+            valid_cols <= 0;
+            r <= 0;
+            c <= 0;
+            op_done <= 0;
+            b_sel <= 0;
+            b_hit <= 0;
+            b_miss <= 0;
+            victim <= 0;
+            rle_len <= 0;
+            rle_ptr <= 0;
+            tok_ptr <= 0;
+            run_mode <= RUN_NONE;
+            run_count <= 0;
+            for (t = 0; t < B_ENTRIES; t = t + 1) tag_valid[t] <= 1'b0;
+        end else begin
+            op_done <= 0;
+            b_hit <= 0;
+            b_miss <= 0;
+
+            if (b_invalidate) tag_valid[b_sel] <= 1'b0;
+
+            case (state)
+                IDLE: begin
+                    if (op_valid && op_code == OP_LOAD_B && lookup_hit) begin
+                        // Tile already resident: just switch to it
+                        b_sel <= lookup_entry;
+                        b_hit <= 1;
+                        op_done <= 1;
+                    end else if (op_valid) begin
+                        if (op_code == OP_LOAD_B) begin
+                            // Refill the victim entry and tag it up front;
+                            // it is only used once the move completes
+                            b_sel <= victim;
+                            victim <= (victim == B_ENTRIES-1) ? 0 : victim + 1;
+                            tag_valid[victim] <= 1'b1;
+                            tag_addr[victim] <= op_addr;
+                            tag_ld[victim] <= op_arg;
+                            tag_ext[victim] <= {op_rows, op_cols};
+                            tag_gen[victim] <= b_gen;
+                            b_miss <= 1;
+                        end
+                        code <= op_code;
+                        base <= op_addr;
+                        arg <= op_arg;
+                        valid_rows <= op_rows;
+                        valid_cols <= op_cols;
+                        r <= 0;
+                        c <= 0;
+                        rle_ptr <= op_addr;
+                        run_mode <= RUN_NONE;
+                        run_count <= 0;
+                        case (op_code)
+                            OP_GEMM:        state <= GEMM_START;
+                            OP_LOAD_A_RLE:  state <= RLE_LOAD;
+                            OP_STORE_C_RLE: state <= RLE_STORE;
+                            default:        state <= MOVE;
+                        endcase
+                    end
+                end
+                MOVE: begin
+                    if (last_elem) begin
+                        op_done <= 1;
+                        state <= IDLE;
+                    end else if (c == cols - 1) begin
+                        r <= r + 1;
+                        c <= 0;
+                    end else begin
+                        c <= c + 1;
+                    end
+                end
+                RLE_LOAD: begin
+                    if (run_count == 0) begin
+                        // Decode a token
+                        run_mode <= rle_byte[7] ? RUN_ZERO : RUN_LIT;
+                        run_count <= rle_byte[6:0] + 1;
+                        rle_ptr <= rle_ptr + 1;
+                    end else begin
+                        if (run_mode == RUN_LIT) rle_ptr <= rle_ptr + 1;
+                        run_count <= run_count - 1;
+                        if (last_elem) begin
+                            op_done <= 1;
+                            state <= IDLE;
+                        end else if (c == cols - 1) begin
+                            r <= r + 1;
+                            c <= 0;
+                        end else begin
+                            c <= c + 1;
+                        end
+                    end
+                end
+                RLE_STORE: begin
+                    if (run_close) begin
+                        if (run_mode == RUN_ZERO) rle_ptr <= rle_ptr + 1;
+                        run_mode <= RUN_NONE;
+                    end else begin
+                        if (c_zero) begin
+                            run_count <= (run_mode == RUN_NONE) ? 1 : run_count + 1;
+                            run_mode <= RUN_ZERO;
+                        end else if (run_mode == RUN_NONE) begin
+                            run_mode <= RUN_LIT;
+                            run_count <= 1;
+                            tok_ptr <= rle_ptr;
+                            rle_ptr <= rle_ptr + 2;
+                        end else begin
+                            run_count <= run_count + 1;
+                            rle_ptr <= rle_ptr + 1;
+                        end
+
+                        if (last_elem) begin
+                            state <= RLE_FLUSH;
+                        end else if (c == cols - 1) begin
+                            r <= r + 1;
+                            c <= 0;
+                        end else begin
+                            c <= c + 1;
+                        end
+                    end
+                end
+                RLE_FLUSH: begin
+                    if (run_close) begin
+                        if (run_mode == RUN_ZERO) rle_ptr <= rle_ptr + 1;
+                        run_mode <= RUN_NONE;
+                    end else begin
+                        rle_len <= rle_ptr - base;
+                        op_done <= 1;
+                        state <= IDLE;
+                    end
+                end
+                GEMM_START: begin
+                    if (core_accept) state <= GEMM_WAIT;
+                end
+                GEMM_WAIT: begin
+                    if (core_done) begin
+                        op_done <= 1;
+                        state <= IDLE;
+                    end
+                end
+            endcase
+        end
+    end
+
+endmodule
@@ -0,0 +1,156 @@
+`timescale 1ns / 1ps
+
+// Walks the tile loops of a large GEMM C[MxP] = A[MxN] * B[NxP] held in the
+// scratchpad, issuing tile_engine operations over the TMxTNxTP compute core:
+//   for i0 in 0..M step TM, j0 in 0..P step TP:
+//       for k0 in 0..N step TN: LOAD_A, LOAD_B, GEMM (accumulate when k0 > 0)
+//       STORE_C
+// Edge tiles carry their valid extent so partial rows/columns are zero-
+// padded on load and clipped on store. Leading dimensions are in bytes.
+module tiled_gemm #(
+    parameter TM = 4,
+    parameter TN = 4,
+    parameter TP = 4
+)(
+    input clk,
+    input rst_n,
+
+    input         start,
+    input  [15:0] dim_m,
+    input  [15:0] dim_n,
+    input  [15:0] dim_p,
+    input  [31:0] a_base,
+    input  [31:0] b_base,
+    input  [31:0] c_base,
+    input  [15:0] lda,
+    input  [15:0] ldb,
+    input  [15:0] ldc,
+    output        busy,
+    output reg    done,
+
+    // Tile engine operation interface
+    output            op_valid,
+    output reg [2:0]  op_code,
+    output reg [31:0] op_addr,
+    output reg [15:0] op_arg,
+    output reg [7:0]  op_rows,
+    output reg [7:0]  op_cols,
+    input             op_ready,
+    input             op_done
+);
+
+    // Tile engine operations
+    localparam TILE_LOAD_A  = 3'd0;
+    localparam TILE_LOAD_B  = 3'd1;
+    localparam TILE_GEMM    = 3'd2;
+    localparam TILE_STORE_C = 3'd3;
+
+    reg        active;
+    reg        last;     // Final STORE_C has been issued
+    reg [2:0]  step;     // Next tile operation
+    reg [15:0] i0, j0, k0;
+
+    // Valid extent of the current tiles
+    wire [15:0] rem_m = dim_m - i0;
+    wire [15:0] rem_n = dim_n - k0;
+    wire [15:0] rem_p = dim_p - j0;
+    wire [7:0]  rows_m = (rem_m < TM) ? rem_m[7:0] : TM;
+    wire [7:0]  cols_n = (rem_n < TN) ? rem_n[7:0] : TN;
+    wire [7:0]  cols_p = (rem_p < TP) ? rem_p[7:0] : TP;
+
+    wire last_k    = (k0 + TN >= dim_n);
+    wire last_j    = (j0 + TP >= dim_p);
+    wire last_i    = (i0 + TM >= dim_m);
+    wire issue     = op_valid && op_ready;
+
+    assign busy     = active;
+    assign op_valid = active && !last;
+
+    always @(*) begin
+        op_code = step;
+        op_arg  = 0;
+        case (step)
+            TILE_LOAD_A: begin
+                op_addr = a_base + i0 * lda + k0;
+                op_arg  = lda;
+                op_rows = rows_m;
+                op_cols = cols_n;
+            end
+            TILE_LOAD_B: begin
+                op_addr = b_base + k0 * ldb + j0;
+                op_arg  = ldb;
+                op_rows = cols_n;
+                op_cols = cols_p;
+            end
+            TILE_GEMM: begin
+                op_addr = 0;
+                op_arg  = (k0 != 0);
+                op_rows = TM;
+                op_cols = TP;
+            end
+            default: begin
+                op_addr = c_base + i0 * ldc + j0 * 4;
+                op_arg  = ldc;
+                op_rows = rows_m;
+                op_cols = cols_p;
+            end
+        endcase
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            active <= 0;
+            last <= 0;
+            step <= TILE_LOAD_A;
+            i0 <= 0;
+            j0 <= 0;
+            k0 <= 0;
+            done <= 0;
+        end else begin
+            done <= 0;
+
+            if (!active) begin
+                if (start && dim_m != 0 && dim_n != 0 && dim_p != 0) begin
+                    active <= 1;
+                    last <= 0;
+                    step <= TILE_LOAD_A;
+                    i0 <= 0;
+                    j0 <= 0;
+                    k0 <= 0;
+                end
+            end else if (last) begin
+                if (op_done) begin
+                    active <= 0;
+                    last <= 0;
+                    done <= 1;
+                end
+            end else if (issue) begin
+                case (step)
+                    TILE_LOAD_A: step <= TILE_LOAD_B;
+                    TILE_LOAD_B: step <= TILE_GEMM;
+                    TILE_GEMM: begin
+                        if (last_k) begin
+                            step <= TILE_STORE_C;
+                        end else begin
+                            k0 <= k0 + TN;
+                            step <= TILE_LOAD_A;
+                        end
+                    end
+                    default: begin
+                        // C tile stored; move to the next output tile
+                        k0 <= 0;
+                        step <= TILE_LOAD_A;
+                        if (last_j) begin
+                            j0 <= 0;
+                            if (last_i) last <= 1;
+                            else i0 <= i0 + TM;
+                        end else begin
+                            j0 <= j0 + TP;
+                        end
+                    end
+                endcase
+            end
+        end
+    end
+
+endmodule
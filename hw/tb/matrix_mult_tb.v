@@ -15,6 +15,7 @@ module matrix_mult_tb;
     reg rst_n;
     reg start;
     wire done;
+    time t_first_done;
 
     // DUT instantiation
     matrix_mult_top #(
@@ -57,13 +58,14 @@ module matrix_mult_tb;
         #CLK_PERIOD;
         rst_n = 1;
         
-        // Start multiplication
+        // Start multiplication (single-cycle start pulse)
         #CLK_PERIOD;
         start = 1;
+        #CLK_PERIOD;
+        start = 0;
         
-        // Wait for done
+        // Wait for the per-job done pulse
         wait(done);
-        start = 0;
         
         #CLK_PERIOD;
 
@@ -80,6 +82,21 @@ module matrix_mult_tb;
                 dut.bram_c_inst.mem[0], dut.bram_c_inst.mem[1],
                 dut.bram_c_inst.mem[2], dut.bram_c_inst.mem[3]);
         end
+
+        // Back-to-back jobs: with start held high the core restarts in the
+        // cycle of its last C write, so done pulses are exactly one job apart
+        @(negedge clk);
+        start = 1;
+        @(posedge done);
+        t_first_done = $time;
+        @(negedge done);
+        @(posedge done);
+        start = 0;
+        if (($time - t_first_done) == M*N*P*5*CLK_PERIOD) begin
+            $display("Back-to-back Test Passed!");
+        end else begin
+            $display("Back-to-back Test Failed! done spacing = %0t", $time - t_first_done);
+        end
         
         $finish;
     end
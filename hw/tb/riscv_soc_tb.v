@@ -154,7 +154,7 @@ module riscv_soc_tb;
         if (rst_n) begin
             // Monitor memory accesses to matrix accelerator
             if (dut.cpu_mem_valid && dut.cpu_mem_ready) begin
-                if (dut.cpu_mem_addr >= 32'h10000000 && dut.cpu_mem_addr <= 32'h100003FF) begin
+                if (dut.cpu_mem_addr >= 32'h10000000 && dut.cpu_mem_addr <= 32'h10003FFF) begin
                     if (dut.cpu_mem_wstrb != 0) begin
                         $display("Time: %0t - Matrix accel WRITE: Addr=0x%08h, Data=0x%08h", 
                                  $time, dut.cpu_mem_addr, dut.cpu_mem_wdata);
@@ -66,12 +66,10 @@ matrix_accel_result_t matrix_accel_load_matrix_b(const matrix_input_t matrix) {
         return MATRIX_ACCEL_ERROR_BUSY;
     }
     
-    // Load matrix elements in row-major order
-    int index = 0;
+    // The core reads B column-major, so transpose while loading
     for (int row = 0; row < MATRIX_SIZE; row++) {
         for (int col = 0; col < MATRIX_SIZE; col++) {
-            hal_write_matrix_b_element(index, matrix[row][col]);
-            index++;
+            hal_write_matrix_b_element(col * MATRIX_SIZE + row, matrix[row][col]);
         }
     }
     
@@ -96,18 +94,14 @@ matrix_accel_result_t matrix_accel_load_matrices(const matrix_input_t matrix_a,
 }
 
 matrix_accel_result_t matrix_accel_start(void) {
-    if (!matrix_accel_is_ready()) {
+    // One job may be queued behind the running one; refuse a second
+    if (hal_read_status() & STATUS_PENDING_BIT) {
         return MATRIX_ACCEL_ERROR_BUSY;
     }
     
-    // Pulse the start bit
+    // The hardware latches the request and clears the start bit itself
     hal_write_control(CONTROL_START_BIT);
     
-    // The hardware automatically clears the start bit after one cycle
-    // But we can also clear it explicitly for safety
-    delay_cycles(2);
-    hal_write_control(0);
-    
     return MATRIX_ACCEL_SUCCESS;
 }
 
@@ -125,6 +119,25 @@ matrix_accel_result_t matrix_accel_wait_done(uint32_t timeout_cycles) {
     return MATRIX_ACCEL_SUCCESS;
 }
 
+matrix_accel_result_t matrix_accel_wait_jobs(uint32_t job_count, uint32_t timeout_cycles) {
+    uint32_t cycles_waited = 0;
+    
+    // Signed difference keeps the comparison valid across counter wrap
+    while ((int32_t)(hal_read_job_count() - job_count) < 0) {
+        if (timeout_cycles > 0 && cycles_waited >= timeout_cycles) {
+            return MATRIX_ACCEL_ERROR_TIMEOUT;
+        }
+        delay_cycles(1);
+        cycles_waited++;
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+uint32_t matrix_accel_get_job_count(void) {
+    return hal_read_job_count();
+}
+
 matrix_accel_result_t matrix_accel_read_result(matrix_output_t result) {
     if (!matrix_accel_is_done()) {
         return MATRIX_ACCEL_ERROR_BUSY;
@@ -142,6 +155,40 @@ matrix_accel_result_t matrix_accel_read_result(matrix_output_t result) {
     return MATRIX_ACCEL_SUCCESS;
 }
 
+matrix_accel_result_t matrix_accel_wait_row(int row, uint32_t timeout_cycles) {
+    if (row < 0 || row >= MATRIX_SIZE) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    uint32_t cycles_waited = 0;
+    
+    while (!(hal_read_status() & STATUS_ROW_VALID_BIT(row))) {
+        if (timeout_cycles > 0 && cycles_waited >= timeout_cycles) {
+            return MATRIX_ACCEL_ERROR_TIMEOUT;
+        }
+        delay_cycles(1);
+        cycles_waited++;
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_read_row(int row, matrix_result_t result[MATRIX_SIZE]) {
+    if (row < 0 || row >= MATRIX_SIZE || !result) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!(hal_read_status() & STATUS_ROW_VALID_BIT(row))) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    for (int col = 0; col < MATRIX_SIZE; col++) {
+        result[col] = hal_read_matrix_c_element(row * MATRIX_SIZE + col);
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
 matrix_accel_result_t matrix_accel_multiply(const matrix_input_t matrix_a,
                                              const matrix_input_t matrix_b,
                                              matrix_output_t result,
@@ -160,18 +207,1359 @@ matrix_accel_result_t matrix_accel_multiply(const matrix_input_t matrix_a,
         return status;
     }
     
-    // Wait for completion
-    status = matrix_accel_wait_done(timeout_cycles);
-    if (status != MATRIX_ACCEL_SUCCESS) {
-        return status;
+    // Drain result rows as they finish instead of waiting for the whole job
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        status = matrix_accel_wait_row(row, timeout_cycles);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+        
+        status = matrix_accel_read_row(row, result[row]);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+static bool in_system_ram(const void* ptr, uint32_t bytes) {
+    uint32_t addr = (uint32_t)(uintptr_t)ptr;
+    return addr >= SYSTEM_RAM_BASE && addr + bytes <= SYSTEM_RAM_BASE + SYSTEM_RAM_SIZE_BYTES;
+}
+
+matrix_accel_result_t matrix_accel_multiply_inplace(const matrix_input_t matrix_a,
+                                                    const matrix_input_t matrix_b,
+                                                    matrix_output_t result,
+                                                    uint32_t timeout_cycles) {
+    matrix_accel_result_t status;
+    
+    if (!in_system_ram(matrix_a, sizeof(matrix_input_t)) ||
+        !in_system_ram(matrix_b, sizeof(matrix_input_t)) ||
+        !in_system_ram(result, sizeof(matrix_output_t)) ||
+        ((uintptr_t)result & 3)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    hal_write_ram_desc(RAM_DESC_A_ADDR, (uint32_t)(uintptr_t)matrix_a);
+    hal_write_ram_desc(RAM_DESC_B_ADDR, (uint32_t)(uintptr_t)matrix_b);
+    hal_write_ram_desc(RAM_DESC_C_ADDR, (uint32_t)(uintptr_t)result);
+    hal_write_ram_desc(RAM_DESC_LDA, MATRIX_SIZE);
+    hal_write_ram_desc(RAM_DESC_LDB, MATRIX_SIZE);
+    hal_write_ram_desc(RAM_DESC_LDC, MATRIX_SIZE * sizeof(matrix_result_t));
+    
+    uint32_t config = hal_read_config();
+    hal_write_config(config | CONFIG_RAM_DIRECT_BIT);
+    
+    status = matrix_accel_start();
+    if (status == MATRIX_ACCEL_SUCCESS) {
+        status = matrix_accel_wait_done(timeout_cycles);
+    }
+    
+    hal_write_config(config & ~CONFIG_RAM_DIRECT_BIT);
+    return status;
+}
+
+matrix_accel_result_t matrix_accel_spmv_csr(const matrix_accel_csr_t* matrix, const int8_t* x,
+                                            int32_t* y, uint32_t timeout_cycles) {
+    if (!matrix || !x || !y || matrix->rows == 0 || matrix->rows > 0xFFFF ||
+        !in_system_ram(matrix->row_ptr, (matrix->rows + 1) * sizeof(uint32_t)) ||
+        !in_system_ram(x, matrix->cols) ||
+        !in_system_ram(y, matrix->rows * sizeof(int32_t)) || ((uintptr_t)y & 3)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    uint32_t nnz = matrix->row_ptr[matrix->rows];
+    if (nnz != 0 && (!in_system_ram(matrix->col_idx, nnz * sizeof(uint32_t)) ||
+                     !in_system_ram(matrix->values, nnz))) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    hal_write_spmv_desc(SPMV_DESC_ROWS, matrix->rows);
+    hal_write_spmv_desc(SPMV_DESC_ROW_PTR, (uint32_t)(uintptr_t)matrix->row_ptr);
+    hal_write_spmv_desc(SPMV_DESC_COL_IDX, (uint32_t)(uintptr_t)matrix->col_idx);
+    hal_write_spmv_desc(SPMV_DESC_VALUES, (uint32_t)(uintptr_t)matrix->values);
+    hal_write_spmv_desc(SPMV_DESC_X, (uint32_t)(uintptr_t)x);
+    hal_write_spmv_desc(SPMV_DESC_Y, (uint32_t)(uintptr_t)y);
+    hal_write_control(CONTROL_SPMV_BIT);
+    
+    return matrix_accel_wait_done(timeout_cycles);
+}
+
+matrix_accel_result_t matrix_accel_cgemm(const matrix_cinput_t matrix_a,
+                                         const matrix_cinput_t matrix_b,
+                                         matrix_coutput_t result,
+                                         uint32_t timeout_cycles) {
+    matrix_accel_result_t status;
+    
+    if (!matrix_a || !matrix_b || !result) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    // B is stored column-major, as for matrix_accel_load_matrix_b()
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        for (int col = 0; col < MATRIX_SIZE; col++) {
+            hal_write_cplx_a_element(row * MATRIX_SIZE + col, matrix_a[row][col].re, matrix_a[row][col].im);
+            hal_write_cplx_b_element(col * MATRIX_SIZE + row, matrix_b[row][col].re, matrix_b[row][col].im);
+        }
+    }
+    
+    uint32_t config = hal_read_config();
+    hal_write_config(config | CONFIG_COMPLEX_BIT);
+    
+    status = matrix_accel_start();
+    if (status == MATRIX_ACCEL_SUCCESS) {
+        status = matrix_accel_wait_done(timeout_cycles);
     }
     
-    // Read results
-    status = matrix_accel_read_result(result);
+    hal_write_config(config & ~CONFIG_COMPLEX_BIT);
     if (status != MATRIX_ACCEL_SUCCESS) {
         return status;
     }
     
+    for (int i = 0; i < MATRIX_ELEMENTS; i++) {
+        result[i / MATRIX_SIZE][i % MATRIX_SIZE].re = (int32_t)hal_read_matrix_c_element(i);
+        result[i / MATRIX_SIZE][i % MATRIX_SIZE].im = hal_read_c_imag_element(i);
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+void matrix_accel_get_ram_conflicts(uint32_t counts[SYSTEM_RAM_BANKS]) {
+    for (int bank = 0; bank < SYSTEM_RAM_BANKS; bank++) {
+        counts[bank] = hal_read_ram_conflicts(bank);
+    }
+}
+
+void matrix_accel_clear_ram_conflicts(void) {
+    hal_clear_ram_conflicts();
+}
+
+matrix_accel_result_t matrix_accel_set_stream_mode(bool enable) {
+    uint32_t config = hal_read_config();
+    
+    if (enable) {
+        config |= CONFIG_STREAM_EN_BIT;
+    } else {
+        config &= ~CONFIG_STREAM_EN_BIT;
+    }
+    hal_write_config(config);
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_set_pe_op(uint32_t op) {
+    if (op > PE_OP_L2) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    uint32_t config = hal_read_config();
+    hal_write_config((config & ~CONFIG_PE_OP_MASK) | (op << CONFIG_PE_OP_SHIFT));
+    matrix_accel_bcache_invalidate();
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_stream_write_row(int row, const matrix_element_t a_row[MATRIX_SIZE]) {
+    if (row < 0 || row >= MATRIX_SIZE || !a_row) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // The write of the last column triggers the row computation
+    for (int col = 0; col < MATRIX_SIZE; col++) {
+        hal_write_matrix_a_element(row * MATRIX_SIZE + col, a_row[col]);
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_stream_frame(const matrix_input_t matrix_a,
+                                                 matrix_output_t result,
+                                                 uint32_t timeout_cycles) {
+    matrix_accel_result_t status;
+    
+    if (!matrix_a || !result || !(hal_read_config() & CONFIG_STREAM_EN_BIT)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        status = matrix_accel_stream_write_row(row, matrix_a[row]);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+    }
+    
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        status = matrix_accel_wait_row(row, timeout_cycles);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+        
+        status = matrix_accel_read_row(row, result[row]);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_scratch_write(uint32_t offset, const void* data, uint32_t bytes) {
+    const uint8_t* src = (const uint8_t*)data;
+    
+    if (!data || (offset & 3) || (bytes & 3) || offset + bytes > SCRATCH_SIZE_BYTES) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // Pack bytes little-endian so unaligned source buffers are fine
+    for (uint32_t i = 0; i < bytes; i += 4) {
+        uint32_t word = (uint32_t)src[i] |
+                        ((uint32_t)src[i + 1] << 8) |
+                        ((uint32_t)src[i + 2] << 16) |
+                        ((uint32_t)src[i + 3] << 24);
+        hal_write_scratch_word(offset + i, word);
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_scratch_read(uint32_t offset, void* data, uint32_t bytes) {
+    uint8_t* dst = (uint8_t*)data;
+    
+    if (!data || (offset & 3) || (bytes & 3) || offset + bytes > SCRATCH_SIZE_BYTES) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    for (uint32_t i = 0; i < bytes; i += 4) {
+        uint32_t word = hal_read_scratch_word(offset + i);
+        dst[i]     = (uint8_t)word;
+        dst[i + 1] = (uint8_t)(word >> 8);
+        dst[i + 2] = (uint8_t)(word >> 16);
+        dst[i + 3] = (uint8_t)(word >> 24);
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+// Whether base + last * stride + tile stays inside the scratchpad, without
+// letting the product wrap
+static bool batch_fits(uint32_t base, uint32_t stride, uint32_t last, uint32_t tile) {
+    if (base > SCRATCH_SIZE_BYTES || tile > SCRATCH_SIZE_BYTES - base) {
+        return false;
+    }
+    return last == 0 || stride <= (SCRATCH_SIZE_BYTES - base - tile) / last;
+}
+
+matrix_accel_result_t matrix_accel_batch_start(const matrix_accel_batch_desc_t* desc) {
+    if (!desc || desc->batch_count == 0) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // Every tile of the last item must still fall inside the scratchpad
+    uint32_t last = desc->batch_count - 1;
+    if (!batch_fits(desc->a_base, desc->a_stride, last, MATRIX_ELEMENTS) ||
+        !batch_fits(desc->b_base, desc->b_stride, last, MATRIX_ELEMENTS) ||
+        !batch_fits(desc->c_base, desc->c_stride, last, MATRIX_ELEMENTS * 4) ||
+        (desc->c_base & 3) || (desc->c_stride & 3)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    hal_write_batch_desc(BATCH_DESC_COUNT, desc->batch_count);
+    hal_write_batch_desc(BATCH_DESC_A_BASE, desc->a_base);
+    hal_write_batch_desc(BATCH_DESC_B_BASE, desc->b_base);
+    hal_write_batch_desc(BATCH_DESC_C_BASE, desc->c_base);
+    hal_write_batch_desc(BATCH_DESC_A_STRIDE, desc->a_stride);
+    hal_write_batch_desc(BATCH_DESC_B_STRIDE, desc->b_stride);
+    hal_write_batch_desc(BATCH_DESC_C_STRIDE, desc->c_stride);
+    
+    hal_write_control(CONTROL_BATCH_BIT);
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_gemm_start(const matrix_accel_gemm_desc_t* desc) {
+    if (!desc || desc->m == 0 || desc->n == 0 || desc->p == 0) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // Rows must not overlap and the last row of each matrix must fit
+    if (desc->lda < desc->n || desc->ldb < desc->p || desc->ldc < desc->p * 4 ||
+        (desc->c_base & 3) || (desc->ldc & 3) ||
+        !batch_fits(desc->a_base, desc->lda, desc->m - 1, desc->n) ||
+        !batch_fits(desc->b_base, desc->ldb, desc->n - 1, desc->p) ||
+        !batch_fits(desc->c_base, desc->ldc, desc->m - 1, (uint32_t)desc->p * 4)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    hal_write_gemm_desc(GEMM_DESC_M, desc->m);
+    hal_write_gemm_desc(GEMM_DESC_N, desc->n);
+    hal_write_gemm_desc(GEMM_DESC_P, desc->p);
+    hal_write_gemm_desc(GEMM_DESC_A_BASE, desc->a_base);
+    hal_write_gemm_desc(GEMM_DESC_B_BASE, desc->b_base);
+    hal_write_gemm_desc(GEMM_DESC_C_BASE, desc->c_base);
+    hal_write_gemm_desc(GEMM_DESC_LDA, desc->lda);
+    hal_write_gemm_desc(GEMM_DESC_LDB, desc->ldb);
+    hal_write_gemm_desc(GEMM_DESC_LDC, desc->ldc);
+    
+    hal_write_control(CONTROL_GEMM_BIT);
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_pool_start(const matrix_accel_pool_desc_t* desc) {
+    if (!desc || (desc->window != 2 && desc->window != 3) || desc->stride == 0 || desc->stride > 15 ||
+        desc->height < desc->window || desc->width < desc->window || desc->channels == 0 ||
+        (desc->src & 3) || (desc->dst & 3)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    uint32_t out_h = (desc->height - desc->window) / desc->stride + 1;
+    uint32_t out_w = (desc->width - desc->window) / desc->stride + 1;
+    if (desc->src + (uint32_t)desc->height * desc->width * desc->channels * 4 > SCRATCH_SIZE_BYTES ||
+        desc->dst + out_h * out_w * desc->channels * 4 > SCRATCH_SIZE_BYTES) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    hal_write_pool_desc(POOL_DESC_SRC, desc->src);
+    hal_write_pool_desc(POOL_DESC_DST, desc->dst);
+    hal_write_pool_desc(POOL_DESC_HEIGHT, desc->height);
+    hal_write_pool_desc(POOL_DESC_WIDTH, desc->width);
+    hal_write_pool_desc(POOL_DESC_CHANNELS, desc->channels);
+    hal_write_pool_desc(POOL_DESC_MODE, POOL_MODE(desc->window, desc->stride, desc->average));
+    
+    hal_write_control(CONTROL_POOL_BIT);
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_seq_load(const uint32_t* program, uint32_t count) {
+    if (!program || count == 0 || count > SEQ_IMEM_WORDS) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    for (uint32_t i = 0; i < count; i++) {
+        hal_write_seq_insn(i, program[i]);
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_seq_start(uint32_t entry_pc) {
+    if (entry_pc >= SEQ_IMEM_WORDS) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    hal_write_seq_entry(entry_pc);
+    hal_write_control(CONTROL_SEQ_START_BIT);
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+void matrix_accel_seq_signal(void) {
+    hal_write_seq_signal();
+}
+
+void matrix_accel_bcache_invalidate(void) {
+    hal_write_b_gen(hal_read_b_gen() + 1);
+}
+
+void matrix_accel_bcache_get_stats(uint32_t* hits, uint32_t* misses) {
+    if (hits) *hits = hal_read_b_hits();
+    if (misses) *misses = hal_read_b_misses();
+}
+
+void matrix_accel_bcache_clear_stats(void) {
+    hal_write_reg32((volatile uint32_t*)B_HITS_REG_ADDR, 0);
+    hal_write_reg32((volatile uint32_t*)B_MISSES_REG_ADDR, 0);
+}
+
+uint32_t matrix_accel_rle_encode(const uint8_t* src, uint32_t count, uint8_t* dst, uint32_t capacity) {
+    uint32_t out = 0;
+    uint32_t i = 0;
+    
+    if (!src || !dst) {
+        return 0;
+    }
+    
+    while (i < count) {
+        uint32_t run = 1;
+        
+        if (src[i] == 0) {
+            while (i + run < count && src[i + run] == 0 && run < RLE_MAX_RUN) {
+                run++;
+            }
+            if (out + 1 > capacity) {
+                return 0;
+            }
+            dst[out++] = (uint8_t)(RLE_ZERO_RUN_BIT | (run - 1));
+        } else {
+            while (i + run < count && src[i + run] != 0 && run < RLE_MAX_RUN) {
+                run++;
+            }
+            if (out + 1 + run > capacity) {
+                return 0;
+            }
+            dst[out++] = (uint8_t)(run - 1);
+            for (uint32_t j = 0; j < run; j++) {
+                dst[out++] = src[i + j];
+            }
+        }
+        i += run;
+    }
+    
+    return out;
+}
+
+matrix_accel_result_t matrix_accel_rle_decode(const uint8_t* src, uint32_t length, uint8_t* dst, uint32_t count) {
+    uint32_t in = 0;
+    uint32_t out = 0;
+    
+    if (!src || !dst) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    while (out < count) {
+        if (in >= length) {
+            return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+        }
+        
+        uint8_t token = src[in++];
+        uint32_t run = (token & (RLE_ZERO_RUN_BIT - 1)) + 1;
+        
+        if (out + run > count) {
+            return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+        }
+        if (token & RLE_ZERO_RUN_BIT) {
+            for (uint32_t j = 0; j < run; j++) {
+                dst[out++] = 0;
+            }
+        } else {
+            if (in + run > length) {
+                return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+            }
+            for (uint32_t j = 0; j < run; j++) {
+                dst[out++] = src[in++];
+            }
+        }
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+uint32_t matrix_accel_get_rle_len(void) {
+    return hal_read_rle_len();
+}
+
+uint32_t matrix_accel_crc32(uint32_t crc, const matrix_result_t* data, uint32_t count) {
+    crc = ~crc;
+    for (uint32_t i = 0; i < count; i++) {
+        crc ^= (uint32_t)data[i];
+        for (int bit = 0; bit < 32; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+void matrix_accel_get_result_crc(uint32_t* job_crc, uint32_t* run_crc) {
+    if (job_crc) {
+        *job_crc = hal_read_crc_job();
+    }
+    if (run_crc) {
+        *run_crc = hal_read_crc_run();
+    }
+}
+
+void matrix_accel_clear_result_crc(void) {
+    hal_clear_crc_run();
+}
+
+// Scratchpad layout of the direct convolution: im2col patches, filter
+// column and output column for up to CONV_DIRECT_CHUNK outputs
+#define CONV_DIRECT_CHUNK       64
+#define CONV_DIRECT_A_BASE      0x000
+#define CONV_DIRECT_B_BASE      0x240
+#define CONV_DIRECT_C_BASE      0x250
+
+matrix_accel_result_t matrix_accel_conv3x3_direct(const int8_t* input, int height, int width,
+                                                  const int8_t kernel[3][3], int32_t* output,
+                                                  uint32_t timeout_cycles) {
+    uint8_t patches[CONV_DIRECT_CHUNK * 9];
+    uint8_t filter[12] = {0};
+    matrix_accel_result_t status;
+    
+    if (!input || !kernel || !output || height < 3 || width < 3) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    int out_w = width - 2;
+    int outputs = (height - 2) * out_w;
+    
+    for (int i = 0; i < 9; i++) {
+        filter[i] = (uint8_t)kernel[i / 3][i % 3];
+    }
+    status = matrix_accel_scratch_write(CONV_DIRECT_B_BASE, filter, sizeof(filter));
+    if (status != MATRIX_ACCEL_SUCCESS) {
+        return status;
+    }
+    // The filter column keeps its address across calls
+    matrix_accel_bcache_invalidate();
+    
+    for (int first = 0; first < outputs; first += CONV_DIRECT_CHUNK) {
+        int count = outputs - first;
+        if (count > CONV_DIRECT_CHUNK) {
+            count = CONV_DIRECT_CHUNK;
+        }
+        
+        // One 9-element patch per output
+        for (int o = 0; o < count; o++) {
+            int y = (first + o) / out_w;
+            int x = (first + o) % out_w;
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    patches[o * 9 + i * 3 + j] = (uint8_t)input[(y + i) * width + x + j];
+                }
+            }
+        }
+        status = matrix_accel_scratch_write(CONV_DIRECT_A_BASE, patches, (count * 9 + 3) & ~3);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+        
+        const matrix_accel_gemm_desc_t desc = {
+            .m = count, .n = 9, .p = 1,
+            .a_base = CONV_DIRECT_A_BASE, .b_base = CONV_DIRECT_B_BASE, .c_base = CONV_DIRECT_C_BASE,
+            .lda = 9, .ldb = 1, .ldc = sizeof(int32_t)
+        };
+        status = matrix_accel_gemm_start(&desc);
+        if (status == MATRIX_ACCEL_SUCCESS) {
+            status = matrix_accel_wait_done(timeout_cycles);
+        }
+        if (status == MATRIX_ACCEL_SUCCESS) {
+            status = matrix_accel_scratch_read(CONV_DIRECT_C_BASE, &output[first], count * sizeof(int32_t));
+        }
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+// Scratchpad layout of the Winograd convolution: transformed filter, then
+// up to WINOGRAD_CHUNK transformed input tiles and their product tiles
+#define WINOGRAD_CHUNK          32
+#define WINOGRAD_U_BASE         0x000
+#define WINOGRAD_V_BASE         0x010
+#define WINOGRAD_M_BASE         (WINOGRAD_V_BASE + WINOGRAD_CHUNK * 16)
+
+static bool fits_int8(int32_t value) {
+    return value >= -128 && value <= 127;
+}
+
+/*
+ * Filter transform U = G g G^T with G = [2 0 0; 1 1 1; 1 -1 1; 0 0 2],
+ * twice the usual matrix so it stays integral. The products, and hence
+ * the outputs, come out 4x too large.
+ */
+static bool winograd_filter(const int8_t g[3][3], int8_t u[4][4]) {
+    int32_t t[4][3];
+    
+    for (int j = 0; j < 3; j++) {
+        t[0][j] = 2 * g[0][j];
+        t[1][j] = g[0][j] + g[1][j] + g[2][j];
+        t[2][j] = g[0][j] - g[1][j] + g[2][j];
+        t[3][j] = 2 * g[2][j];
+    }
+    for (int i = 0; i < 4; i++) {
+        int32_t row[4] = {
+            2 * t[i][0],
+            t[i][0] + t[i][1] + t[i][2],
+            t[i][0] - t[i][1] + t[i][2],
+            2 * t[i][2]
+        };
+        for (int j = 0; j < 4; j++) {
+            if (!fits_int8(row[j])) {
+                return false;
+            }
+            u[i][j] = (int8_t)row[j];
+        }
+    }
+    return true;
+}
+
+// Input transform V = B^T d B, B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1]
+static void winograd_input(const int32_t d[4][4], int8_t v[4][4]) {
+    int32_t t[4][4];
+    
+    for (int j = 0; j < 4; j++) {
+        t[0][j] = d[0][j] - d[2][j];
+        t[1][j] = d[1][j] + d[2][j];
+        t[2][j] = d[2][j] - d[1][j];
+        t[3][j] = d[1][j] - d[3][j];
+    }
+    for (int i = 0; i < 4; i++) {
+        v[i][0] = (int8_t)(t[i][0] - t[i][2]);
+        v[i][1] = (int8_t)(t[i][1] + t[i][2]);
+        v[i][2] = (int8_t)(t[i][2] - t[i][1]);
+        v[i][3] = (int8_t)(t[i][1] - t[i][3]);
+    }
+}
+
+// Output transform Y = A^T m A / 4, A^T = [1 1 1 0; 0 1 -1 -1]
+static void winograd_output(const int32_t m[4][4], int32_t y[2][2]) {
+    int32_t t[2][4];
+    
+    for (int j = 0; j < 4; j++) {
+        t[0][j] = m[0][j] + m[1][j] + m[2][j];
+        t[1][j] = m[1][j] - m[2][j] - m[3][j];
+    }
+    for (int i = 0; i < 2; i++) {
+        // Exact: the scaled filter makes every output a multiple of 4
+        y[i][0] = (t[i][0] + t[i][1] + t[i][2]) >> 2;
+        y[i][1] = (t[i][1] - t[i][2] - t[i][3]) >> 2;
+    }
+}
+
+matrix_accel_result_t matrix_accel_conv3x3_winograd(const int8_t* input, int height, int width,
+                                                    const int8_t kernel[3][3], int32_t* output,
+                                                    uint32_t timeout_cycles) {
+    int8_t u[4][4];
+    int8_t v[WINOGRAD_CHUNK][4][4];
+    int32_t m[4][4];
+    matrix_accel_result_t status;
+    
+    if (!input || !kernel || !output || height < 3 || width < 3 ||
+        !winograd_filter(kernel, u)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    for (int i = 0; i < height * width; i++) {
+        if (input[i] > WINOGRAD_INPUT_MAX || input[i] < -WINOGRAD_INPUT_MAX) {
+            return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+        }
+    }
+    
+    int out_h = height - 2;
+    int out_w = width - 2;
+    int tiles_x = (out_w + 1) / 2;
+    int tiles = ((out_h + 1) / 2) * tiles_x;
+    
+    status = matrix_accel_scratch_write(WINOGRAD_U_BASE, u, sizeof(u));
+    if (status != MATRIX_ACCEL_SUCCESS) {
+        return status;
+    }
+    // The filter tile keeps its address across calls
+    matrix_accel_bcache_invalidate();
+    
+    for (int first = 0; first < tiles; first += WINOGRAD_CHUNK) {
+        int count = tiles - first;
+        if (count > WINOGRAD_CHUNK) {
+            count = WINOGRAD_CHUNK;
+        }
+        
+        // 4x4 input tiles overlap by two; reads past the edge are zero
+        for (int t = 0; t < count; t++) {
+            int y0 = ((first + t) / tiles_x) * 2;
+            int x0 = ((first + t) % tiles_x) * 2;
+            int32_t d[4][4];
+            for (int i = 0; i < 4; i++) {
+                for (int j = 0; j < 4; j++) {
+                    bool inside = (y0 + i < height) && (x0 + j < width);
+                    d[i][j] = inside ? input[(y0 + i) * width + x0 + j] : 0;
+                }
+            }
+            winograd_input(d, v[t]);
+        }
+        status = matrix_accel_scratch_write(WINOGRAD_V_BASE, v, count * sizeof(v[0]));
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+        
+        const uint32_t program[] = {
+            SEQ_SETA(0, WINOGRAD_U_BASE),
+            SEQ_LDB(0, MATRIX_SIZE),
+            SEQ_SETA(1, WINOGRAD_V_BASE),
+            SEQ_SETA(2, WINOGRAD_M_BASE),
+            SEQ_SETC(0, count),
+            /* 5: */ SEQ_LDA(1, MATRIX_SIZE),
+            SEQ_ELT(SEQ_ELT_MUL),
+            SEQ_STC(2, MATRIX_SIZE * sizeof(int32_t)),
+            SEQ_ADDA(1, sizeof(v[0])),
+            SEQ_ADDA(2, sizeof(m)),
+            SEQ_LOOP(0, 5),
+            SEQ_END()
+        };
+        status = matrix_accel_seq_load(program, sizeof(program) / sizeof(program[0]));
+        if (status == MATRIX_ACCEL_SUCCESS) {
+            status = matrix_accel_seq_start(0);
+        }
+        if (status == MATRIX_ACCEL_SUCCESS) {
+            status = matrix_accel_wait_done(timeout_cycles);
+        }
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+        
+        for (int t = 0; t < count; t++) {
+            int y0 = ((first + t) / tiles_x) * 2;
+            int x0 = ((first + t) % tiles_x) * 2;
+            int32_t y[2][2];
+            
+            status = matrix_accel_scratch_read(WINOGRAD_M_BASE + t * sizeof(m), m, sizeof(m));
+            if (status != MATRIX_ACCEL_SUCCESS) {
+                return status;
+            }
+            winograd_output(m, y);
+            for (int i = 0; i < 2 && y0 + i < out_h; i++) {
+                for (int j = 0; j < 2 && x0 + j < out_w; j++) {
+                    output[(y0 + i) * out_w + x0 + j] = y[i][j];
+                }
+            }
+        }
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+uint8_t matrix_accel_gf_mul(uint8_t a, uint8_t b, uint8_t poly) {
+    uint8_t product = 0;
+    
+    // Same shift-and-add as the PE
+    for (int n = 0; n < 8; n++) {
+        if (b & (1 << n)) {
+            product ^= a;
+        }
+        a = (a & 0x80) ? (uint8_t)((a << 1) ^ poly) : (uint8_t)(a << 1);
+    }
+    
+    return product;
+}
+
+// Scratchpad layout of the erasure encoder: coding matrix, then one chunk of
+// every data block (row-major) and the parity chunks as 32-bit elements
+#define GF_CHUNK_MAX            128
+#define GF_CODING_BASE          0x000
+#define GF_DATA_BASE            0x100
+
+matrix_accel_result_t matrix_accel_gf_encode(const uint8_t* coding, int parity_blocks,
+                                             const uint8_t* const data[], int data_blocks,
+                                             uint8_t* const parity[], uint32_t block_len,
+                                             uint8_t poly, uint32_t timeout_cycles) {
+    uint8_t coding_tile[GF_MAX_BLOCKS * GF_MAX_BLOCKS];
+    uint32_t words[GF_CHUNK_MAX];
+    matrix_accel_result_t status;
+    
+    if (!coding || !data || !parity || parity_blocks < 1 || parity_blocks > GF_MAX_BLOCKS ||
+        data_blocks < 1 || data_blocks > GF_MAX_BLOCKS || block_len == 0 || (block_len & 3)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // Largest chunk whose data and parity fit behind the coding matrix
+    uint32_t chunk = ((SCRATCH_SIZE_BYTES - GF_DATA_BASE) /
+                      (uint32_t)(data_blocks + parity_blocks * sizeof(uint32_t))) & ~3u;
+    if (chunk > GF_CHUNK_MAX) {
+        chunk = GF_CHUNK_MAX;
+    }
+    
+    uint32_t coding_bytes = (uint32_t)(parity_blocks * data_blocks);
+    for (uint32_t i = 0; i < coding_bytes; i++) {
+        coding_tile[i] = coding[i];
+    }
+    status = matrix_accel_scratch_write(GF_CODING_BASE, coding_tile, (coding_bytes + 3) & ~3u);
+    if (status != MATRIX_ACCEL_SUCCESS) {
+        return status;
+    }
+    
+    uint32_t config = hal_read_config();
+    hal_write_gf_poly(poly);
+    hal_write_config((config & ~CONFIG_PE_OP_MASK) | (PE_OP_GF << CONFIG_PE_OP_SHIFT));
+    
+    for (uint32_t first = 0; first < block_len && status == MATRIX_ACCEL_SUCCESS; first += chunk) {
+        uint32_t count = block_len - first;
+        if (count > chunk) {
+            count = chunk;
+        }
+        uint32_t parity_base = GF_DATA_BASE + data_blocks * count;
+        
+        for (int r = 0; r < data_blocks && status == MATRIX_ACCEL_SUCCESS; r++) {
+            status = matrix_accel_scratch_write(GF_DATA_BASE + r * count, &data[r][first], count);
+        }
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            break;
+        }
+        // The data tiles reuse their addresses every chunk
+        matrix_accel_bcache_invalidate();
+        
+        const matrix_accel_gemm_desc_t desc = {
+            .m = parity_blocks, .n = data_blocks, .p = count,
+            .a_base = GF_CODING_BASE, .b_base = GF_DATA_BASE, .c_base = parity_base,
+            .lda = data_blocks, .ldb = count, .ldc = count * sizeof(uint32_t)
+        };
+        status = matrix_accel_gemm_start(&desc);
+        if (status == MATRIX_ACCEL_SUCCESS) {
+            status = matrix_accel_wait_done(timeout_cycles);
+        }
+        
+        // Field elements come back in the low byte of each result
+        for (int r = 0; r < parity_blocks && status == MATRIX_ACCEL_SUCCESS; r++) {
+            status = matrix_accel_scratch_read(parity_base + r * count * sizeof(uint32_t),
+                                               words, count * sizeof(uint32_t));
+            for (uint32_t i = 0; i < count && status == MATRIX_ACCEL_SUCCESS; i++) {
+                parity[r][first + i] = (uint8_t)words[i];
+            }
+        }
+    }
+    
+    hal_write_config(config);
+    return status;
+}
+
+// Scratchpad base of the binary GEMM operands; B and C follow A
+#define BINARY_A_BASE           0x000
+
+matrix_accel_result_t matrix_accel_binary_gemm(const uint32_t* a_bits, const uint32_t* b_bits,
+                                               int m, int p, int k_words, int32_t* result,
+                                               uint32_t timeout_cycles) {
+    matrix_accel_result_t status;
+    
+    if (!a_bits || !b_bits || !result || m < 1 || p < 1 || k_words < 1) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // A rows are the packed words as they are; B is transposed so each
+    // scratchpad row holds byte kb of every column's bits
+    uint32_t lda = k_words * sizeof(uint32_t);
+    uint32_t ldb = (p + 3) & ~3u;
+    uint32_t b_base = BINARY_A_BASE + m * lda;
+    uint32_t c_base = b_base + lda * ldb;
+    if (c_base + m * p * sizeof(int32_t) > SCRATCH_SIZE_BYTES) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    status = matrix_accel_scratch_write(BINARY_A_BASE, a_bits, m * lda);
+    if (status != MATRIX_ACCEL_SUCCESS) {
+        return status;
+    }
+    for (uint32_t kb = 0; kb < lda; kb++) {
+        for (uint32_t j = 0; j < ldb; j += 4) {
+            uint32_t word = 0;
+            for (uint32_t n = 0; n < 4 && j + n < (uint32_t)p; n++) {
+                uint32_t bits = b_bits[(j + n) * k_words + kb / 4];
+                word |= ((bits >> ((kb % 4) * 8)) & 0xFF) << (n * 8);
+            }
+            hal_write_scratch_word(b_base + kb * ldb + j, word);
+        }
+    }
+    matrix_accel_bcache_invalidate();
+    
+    // Every tile step consumes one packed word of the inner dimension
+    const matrix_accel_gemm_desc_t desc = {
+        .m = m, .n = lda, .p = p,
+        .a_base = BINARY_A_BASE, .b_base = b_base, .c_base = c_base,
+        .lda = lda, .ldb = ldb, .ldc = p * sizeof(int32_t)
+    };
+    uint32_t config = hal_read_config();
+    hal_write_config((config & ~CONFIG_PE_OP_MASK) | (PE_OP_XNOR << CONFIG_PE_OP_SHIFT));
+    
+    status = matrix_accel_gemm_start(&desc);
+    if (status == MATRIX_ACCEL_SUCCESS) {
+        status = matrix_accel_wait_done(timeout_cycles);
+    }
+    
+    hal_write_config(config);
+    if (status != MATRIX_ACCEL_SUCCESS) {
+        return status;
+    }
+    
+    return matrix_accel_scratch_read(c_base, result, m * p * sizeof(int32_t));
+}
+
+// Scratchpad layout of the distance computation: a chunk of queries, the
+// transposed reference chunk and the distances between them
+#define DIST_Q_CHUNK            8
+#define DIST_R_CHUNK            16
+#define DIST_A_BASE             0x000
+#define DIST_B_BASE             (DIST_A_BASE + DIST_Q_CHUNK * DIST_MAX_DIM)
+#define DIST_C_BASE             (DIST_B_BASE + DIST_MAX_DIM * DIST_R_CHUNK)
+
+matrix_accel_result_t matrix_accel_pairwise_dist(const int8_t* queries, int num_queries,
+                                                 const int8_t* refs, int num_refs, int dim,
+                                                 uint32_t metric, int32_t* dist,
+                                                 int32_t* min_dist, int* argmin,
+                                                 uint32_t timeout_cycles) {
+    uint8_t row[DIST_MAX_DIM] = {0};
+    int32_t c_row[DIST_R_CHUNK];
+    matrix_accel_result_t status = MATRIX_ACCEL_SUCCESS;
+    
+    if (!queries || !refs || num_queries < 1 || num_refs < 1 || dim < 1 || dim > DIST_MAX_DIM ||
+        (metric != PE_OP_L1 && metric != PE_OP_L2) || (!dist && !min_dist) || (argmin && !min_dist)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    for (int q = 0; q < num_queries; q++) {
+        if (min_dist) min_dist[q] = INT32_MAX;
+        if (argmin) argmin[q] = -1;
+    }
+    
+    // Zero padding adds nothing to either distance, so ragged edge tiles
+    // need no special care
+    uint32_t lda = (dim + 3) & ~3;
+    uint32_t config = hal_read_config();
+    hal_write_config((config & ~CONFIG_PE_OP_MASK) | (metric << CONFIG_PE_OP_SHIFT));
+    
+    // References outermost so each chunk is transposed into the scratchpad
+    // once and reused by every query chunk (the B cache holds only a few of
+    // its tiles, so those are refetched per query chunk)
+    for (int r0 = 0; r0 < num_refs && status == MATRIX_ACCEL_SUCCESS; r0 += DIST_R_CHUNK) {
+        int nr = num_refs - r0;
+        if (nr > DIST_R_CHUNK) {
+            nr = DIST_R_CHUNK;
+        }
+        for (int k = 0; k < dim; k++) {
+            for (int j = 0; j < DIST_R_CHUNK; j += 4) {
+                uint32_t word = 0;
+                for (int n = 0; n < 4 && j + n < nr; n++) {
+                    word |= (uint32_t)(uint8_t)refs[(r0 + j + n) * dim + k] << (n * 8);
+                }
+                hal_write_scratch_word(DIST_B_BASE + k * DIST_R_CHUNK + j, word);
+            }
+        }
+        matrix_accel_bcache_invalidate();
+        
+        for (int q0 = 0; q0 < num_queries && status == MATRIX_ACCEL_SUCCESS; q0 += DIST_Q_CHUNK) {
+            int nq = num_queries - q0;
+            if (nq > DIST_Q_CHUNK) {
+                nq = DIST_Q_CHUNK;
+            }
+            for (int i = 0; i < nq && status == MATRIX_ACCEL_SUCCESS; i++) {
+                for (int k = 0; k < dim; k++) {
+                    row[k] = (uint8_t)queries[(q0 + i) * dim + k];
+                }
+                status = matrix_accel_scratch_write(DIST_A_BASE + i * lda, row, lda);
+            }
+            if (status != MATRIX_ACCEL_SUCCESS) {
+                break;
+            }
+            
+            const matrix_accel_gemm_desc_t desc = {
+                .m = nq, .n = dim, .p = nr,
+                .a_base = DIST_A_BASE, .b_base = DIST_B_BASE, .c_base = DIST_C_BASE,
+                .lda = lda, .ldb = DIST_R_CHUNK, .ldc = nr * sizeof(int32_t)
+            };
+            status = matrix_accel_gemm_start(&desc);
+            if (status == MATRIX_ACCEL_SUCCESS) {
+                status = matrix_accel_wait_done(timeout_cycles);
+            }
+            
+            // Reduce each row as it comes back; ties keep the lower index
+            for (int i = 0; i < nq && status == MATRIX_ACCEL_SUCCESS; i++) {
+                int q = q0 + i;
+                status = matrix_accel_scratch_read(DIST_C_BASE + i * desc.ldc, c_row, desc.ldc);
+                for (int j = 0; j < nr && status == MATRIX_ACCEL_SUCCESS; j++) {
+                    if (dist) {
+                        dist[q * num_refs + r0 + j] = c_row[j];
+                    }
+                    if (min_dist && c_row[j] < min_dist[q]) {
+                        min_dist[q] = c_row[j];
+                        if (argmin) argmin[q] = r0 + j;
+                    }
+                }
+            }
+        }
+    }
+    
+    hal_write_config(config);
+    return status;
+}
+
+// Depthwise convolution works on groups of 16 channels, one per element of
+// a 4x4 tile. Scratchpad layout: the nine weight tiles, then a strip of
+// input pixels (16 bytes each) and the output pixels (16 int32 each).
+#define DW_GROUP                MATRIX_ELEMENTS
+#define DW_W_BASE               0x000
+#define DW_IN_BASE              0x100
+#define DW_PIXEL_OUT            (DW_GROUP * sizeof(int32_t))
+
+matrix_accel_result_t matrix_accel_dwconv2d(const int8_t* input, int height, int width,
+                                            int channels, const int8_t* weights, int stride,
+                                            int32_t* output, uint32_t timeout_cycles) {
+    uint32_t program[SEQ_IMEM_WORDS];
+    int32_t pixel[DW_GROUP];
+    matrix_accel_result_t status = MATRIX_ACCEL_SUCCESS;
+    
+    if (!input || !weights || !output || height < 3 || width < 3 || width > DWCONV_MAX_WIDTH ||
+        channels < 1 || (stride != 1 && stride != 2)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    int out_h = (height - 3) / stride + 1;
+    int out_w = (width - 3) / stride + 1;
+    int row_bytes = width * DW_GROUP;
+    
+    // Output rows per strip: its input rows and results must fit
+    int strip = 1;
+    while (strip < out_h &&
+           DW_IN_BASE + (strip * stride + 3) * row_bytes + (strip + 1) * out_w * DW_PIXEL_OUT <= SCRATCH_SIZE_BYTES) {
+        strip++;
+    }
+    
+    for (int c0 = 0; c0 < channels && status == MATRIX_ACCEL_SUCCESS; c0 += DW_GROUP) {
+        int nc = channels - c0;
+        if (nc > DW_GROUP) {
+            nc = DW_GROUP;
+        }
+        
+        // Tap t of every channel in the group forms weight tile t
+        for (int t = 0; t < 9; t++) {
+            for (int c = 0; c < DW_GROUP; c += 4) {
+                uint32_t word = 0;
+                for (int n = 0; n < 4 && c + n < nc; n++) {
+                    word |= (uint32_t)(uint8_t)weights[(c0 + c + n) * 9 + t] << (n * 8);
+                }
+                hal_write_scratch_word(DW_W_BASE + t * DW_GROUP + c, word);
+            }
+        }
+        matrix_accel_bcache_invalidate();
+        
+        for (int y0 = 0; y0 < out_h && status == MATRIX_ACCEL_SUCCESS; y0 += strip) {
+            int rows = out_h - y0;
+            if (rows > strip) {
+                rows = strip;
+            }
+            int in_rows = (rows - 1) * stride + 3;
+            uint32_t out_base = DW_IN_BASE + in_rows * row_bytes;
+            
+            for (int y = 0; y < in_rows; y++) {
+                for (int x = 0; x < width; x++) {
+                    const int8_t* src = &input[((y0 * stride + y) * width + x) * channels + c0];
+                    for (int c = 0; c < DW_GROUP; c += 4) {
+                        uint32_t word = 0;
+                        for (int n = 0; n < 4 && c + n < nc; n++) {
+                            word |= (uint32_t)(uint8_t)src[c + n] << (n * 8);
+                        }
+                        hal_write_scratch_word(DW_IN_BASE + (y * width + x) * DW_GROUP + c, word);
+                    }
+                }
+            }
+            
+            // a0 walks the window taps, a1 the weight tiles, a2 the outputs;
+            // the first tap multiplies and the other eight accumulate
+            int n = 0;
+            program[n++] = SEQ_SETA(0, DW_IN_BASE);
+            program[n++] = SEQ_SETA(2, out_base);
+            program[n++] = SEQ_SETC(0, rows);
+            int row_loop = n;
+            program[n++] = SEQ_SETC(1, out_w);
+            int pixel_loop = n;
+            program[n++] = SEQ_SETA(1, DW_W_BASE);
+            program[n++] = SEQ_LDA(0, MATRIX_SIZE);
+            program[n++] = SEQ_LDB(1, MATRIX_SIZE);
+            program[n++] = SEQ_ELT(SEQ_ELT_MUL);
+            for (int t = 1; t < 9; t++) {
+                program[n++] = SEQ_ADDA(0, (t % 3) ? DW_GROUP : (width - 2) * DW_GROUP);
+                program[n++] = SEQ_ADDA(1, DW_GROUP);
+                program[n++] = SEQ_LDA(0, MATRIX_SIZE);
+                program[n++] = SEQ_LDB(1, MATRIX_SIZE);
+                program[n++] = SEQ_ELT(SEQ_ELT_MAC);
+            }
+            program[n++] = SEQ_STC(2, MATRIX_SIZE * sizeof(int32_t));
+            program[n++] = SEQ_ADDA(2, DW_PIXEL_OUT);
+            program[n++] = SEQ_ADDA(0, (stride - 2 * width - 2) * DW_GROUP);
+            program[n++] = SEQ_LOOP(1, pixel_loop);
+            program[n++] = SEQ_ADDA(0, stride * (width - out_w) * DW_GROUP);
+            program[n++] = SEQ_LOOP(0, row_loop);
+            program[n++] = SEQ_END();
+            
+            status = matrix_accel_seq_load(program, n);
+            if (status == MATRIX_ACCEL_SUCCESS) {
+                status = matrix_accel_seq_start(0);
+            }
+            if (status == MATRIX_ACCEL_SUCCESS) {
+                status = matrix_accel_wait_done(timeout_cycles);
+            }
+            
+            for (int p = 0; p < rows * out_w && status == MATRIX_ACCEL_SUCCESS; p++) {
+                status = matrix_accel_scratch_read(out_base + p * DW_PIXEL_OUT, pixel, sizeof(pixel));
+                int32_t* dst = &output[((y0 * out_w) + p) * channels + c0];
+                for (int c = 0; c < nc; c++) {
+                    dst[c] = pixel[c];
+                }
+            }
+        }
+    }
+    
+    return status;
+}
+
+matrix_accel_result_t matrix_accel_softmax(uint32_t shift, uint8_t probs[MATRIX_SIZE][MATRIX_SIZE],
+                                           uint32_t timeout_cycles) {
+    if (shift > SOFTMAX_MAX_SHIFT) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    hal_write_softmax_shift(shift);
+    hal_write_control(CONTROL_SOFTMAX_BIT);
+    
+    matrix_accel_result_t status = matrix_accel_wait_done(timeout_cycles);
+    if (status != MATRIX_ACCEL_SUCCESS || !probs) {
+        return status;
+    }
+    
+    int index = 0;
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        for (int col = 0; col < MATRIX_SIZE; col++) {
+            probs[row][col] = (uint8_t)hal_read_matrix_c_element(index);
+            index++;
+        }
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_layernorm(const matrix_accel_norm_desc_t* desc,
+                                             uint32_t timeout_cycles) {
+    if (!desc || desc->rows == 0 || desc->len < 2 ||
+        (desc->src & 3) || (desc->dst & 3) || (desc->params & 3)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    uint32_t bytes = (uint32_t)desc->rows * desc->len * 4;
+    if (desc->src + bytes > SCRATCH_SIZE_BYTES || desc->dst + bytes > SCRATCH_SIZE_BYTES ||
+        desc->params + (uint32_t)desc->len * 4 > SCRATCH_SIZE_BYTES) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    hal_write_norm_desc(NORM_DESC_SRC, desc->src);
+    hal_write_norm_desc(NORM_DESC_DST, desc->dst);
+    hal_write_norm_desc(NORM_DESC_PARAMS, desc->params);
+    hal_write_norm_desc(NORM_DESC_ROWS, desc->rows);
+    hal_write_norm_desc(NORM_DESC_LEN, desc->len);
+    hal_write_norm_desc(NORM_DESC_INV_LEN, 0xFFFFFFFFU / desc->len + 1);
+    hal_write_norm_desc(NORM_DESC_EPS, desc->eps);
+    hal_write_norm_desc(NORM_DESC_MODE, desc->rms ? NORM_MODE_RMS : 0);
+    
+    hal_write_control(CONTROL_NORM_BIT);
+    
+    return matrix_accel_wait_done(timeout_cycles);
+}
+
+matrix_accel_result_t matrix_accel_attention(const matrix_input_t q, const matrix_input_t k,
+                                             const matrix_input_t v, uint32_t shift,
+                                             matrix_output_t result, uint32_t timeout_cycles) {
+    if (shift > SOFTMAX_MAX_SHIFT) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // Both products write C, so a forwarding link would pass the scores on.
+    // Rewriting CHAIN_CTRL here would restart an incoming A fill instead.
+    if (hal_read_unit_reg32(0, CHAIN_CTRL_REG_OFFSET) & CHAIN_OUT_EN_BIT) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!matrix_accel_is_ready()) {
+        return MATRIX_ACCEL_ERROR_BUSY;
+    }
+    
+    // K goes into B unchanged: column j of the column-major B is key j, so
+    // the core sees K^T. V uses the B layout.
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        for (int col = 0; col < MATRIX_SIZE; col++) {
+            hal_write_matrix_a_element(row * MATRIX_SIZE + col, q[row][col]);
+            hal_write_matrix_b_element(row * MATRIX_SIZE + col, k[row][col]);
+            hal_write_attn_v_element(col * MATRIX_SIZE + row, v[row][col]);
+        }
+    }
+    
+    // Both products are plain CPU-style jobs
+    uint32_t config = hal_read_config();
+    hal_write_config(config & ~(CONFIG_STREAM_EN_BIT | CONFIG_RAM_DIRECT_BIT |
+                                CONFIG_COMPLEX_BIT | CONFIG_PE_OP_MASK));
+    hal_write_softmax_shift(shift);
+    hal_write_control(CONTROL_ATTN_BIT);
+    
+    matrix_accel_result_t status = matrix_accel_wait_done(timeout_cycles);
+    hal_write_config(config);
+    if (status != MATRIX_ACCEL_SUCCESS) {
+        return status;
+    }
+    
+    int index = 0;
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        for (int col = 0; col < MATRIX_SIZE; col++) {
+            result[row][col] = hal_read_matrix_c_element(index);
+            index++;
+        }
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_unit_load_matrix_b(int unit, const matrix_input_t matrix) {
+    if (unit < 0 || unit >= MATRIX_ACCEL_NUM_UNITS || !matrix) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // Column-major, as for matrix_accel_load_matrix_b()
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        for (int col = 0; col < MATRIX_SIZE; col++) {
+            hal_write_unit_reg32(unit, MATRIX_B_BASE_OFFSET + (col * MATRIX_SIZE + row) * 4,
+                                 (uint32_t)matrix[row][col]);
+        }
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_bcast_load_matrix_b(uint32_t unit_mask, const matrix_input_t matrix) {
+    if (!matrix || unit_mask == 0 || (unit_mask & ~BCAST_MASK_ALL)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // One store per element reaches every selected unit
+    hal_write_bcast_mask(unit_mask);
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        for (int col = 0; col < MATRIX_SIZE; col++) {
+            hal_write_bcast_reg32(MATRIX_B_BASE_OFFSET + (col * MATRIX_SIZE + row) * 4,
+                                  (uint32_t)matrix[row][col]);
+        }
+    }
+    hal_write_bcast_mask(BCAST_MASK_ALL);
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_chain_config(int unit, bool forward_out, bool accept_in,
+                                                uint32_t out_shift) {
+    if (unit < 0 || unit >= MATRIX_ACCEL_NUM_UNITS || out_shift > 31) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    // The first unit has no upstream link and the last has no downstream one
+    if ((accept_in && unit == 0) || (forward_out && unit == MATRIX_ACCEL_NUM_UNITS - 1)) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    uint32_t ctrl = out_shift << CHAIN_SHIFT_SHIFT;
+    if (forward_out) ctrl |= CHAIN_OUT_EN_BIT;
+    if (accept_in) ctrl |= CHAIN_IN_EN_BIT;
+    hal_write_unit_reg32(unit, CHAIN_CTRL_REG_OFFSET, ctrl);
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_unit_read_row(int unit, int row,
+                                                 matrix_result_t result[MATRIX_SIZE],
+                                                 uint32_t timeout_cycles) {
+    if (unit < 0 || unit >= MATRIX_ACCEL_NUM_UNITS ||
+        row < 0 || row >= MATRIX_SIZE || !result) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    uint32_t cycles_waited = 0;
+    
+    while (!(hal_read_unit_reg32(unit, STATUS_REG_OFFSET) & STATUS_ROW_VALID_BIT(row))) {
+        if (timeout_cycles > 0 && cycles_waited >= timeout_cycles) {
+            return MATRIX_ACCEL_ERROR_TIMEOUT;
+        }
+        delay_cycles(1);
+        cycles_waited++;
+    }
+    
+    for (int col = 0; col < MATRIX_SIZE; col++) {
+        result[col] = (matrix_result_t)hal_read_unit_reg32(unit,
+            MATRIX_C_BASE_OFFSET + (row * MATRIX_SIZE + col) * 4);
+    }
+    
+    return MATRIX_ACCEL_SUCCESS;
+}
+
+matrix_accel_result_t matrix_accel_chain_setup(int num_units, const matrix_input_t weights[],
+                                               uint32_t shift) {
+    matrix_accel_result_t status;
+    
+    if (num_units < 1 || num_units > MATRIX_ACCEL_NUM_UNITS || !weights || shift > 31) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    for (int unit = 0; unit < num_units; unit++) {
+        status = matrix_accel_unit_load_matrix_b(unit, weights[unit]);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+        
+        // Every unit but the last forwards its results to the next layer
+        status = matrix_accel_chain_config(unit, unit < num_units - 1, unit > 0, shift);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+    }
+    
+    // The CPU feeds the first layer row by row
+    return matrix_accel_set_stream_mode(true);
+}
+
+matrix_accel_result_t matrix_accel_chain_frame(int num_units, const matrix_input_t matrix_a,
+                                               matrix_output_t result, uint32_t timeout_cycles) {
+    matrix_accel_result_t status;
+    
+    if (num_units < 1 || num_units > MATRIX_ACCEL_NUM_UNITS) {
+        return MATRIX_ACCEL_ERROR_INVALID_PARAM;
+    }
+    
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        status = matrix_accel_stream_write_row(row, matrix_a[row]);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+    }
+    
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        status = matrix_accel_unit_read_row(num_units - 1, row, result[row], timeout_cycles);
+        if (status != MATRIX_ACCEL_SUCCESS) {
+            return status;
+        }
+    }
+    
     return MATRIX_ACCEL_SUCCESS;
 }
 
@@ -28,10 +28,123 @@ typedef enum {
     MATRIX_ACCEL_ERROR_INVALID_PARAM = -3
 } matrix_accel_result_t;
 
+// Largest input magnitude matrix_accel_conv3x3_winograd() accepts
+#define WINOGRAD_INPUT_MAX      31
+
+// Most data or parity blocks matrix_accel_gf_encode() takes
+#define GF_MAX_BLOCKS           16
+
+// Longest vectors matrix_accel_pairwise_dist() takes
+#define DIST_MAX_DIM            128
+
+// Widest input matrix_accel_dwconv2d() takes
+#define DWCONV_MAX_WIDTH        32
+
 // Matrix type definitions for convenience
 typedef matrix_element_t matrix_input_t[MATRIX_SIZE][MATRIX_SIZE];
 typedef matrix_result_t  matrix_output_t[MATRIX_SIZE][MATRIX_SIZE];
 
+/**
+ * @brief Sparse matrix in compressed sparse row form
+ * 
+ * Row r holds the nonzeros row_ptr[r] .. row_ptr[r+1]-1 of col_idx and
+ * values. All arrays must live in system RAM for the SpMV unit to read.
+ */
+typedef struct {
+    uint32_t rows;
+    uint32_t cols;
+    const uint32_t* row_ptr;   // rows + 1 entries
+    const uint32_t* col_idx;
+    const int8_t* values;
+} matrix_accel_csr_t;
+
+// Complex operands and results for matrix_accel_cgemm()
+typedef struct {
+    int8_t re;
+    int8_t im;
+} matrix_complex_t;
+
+typedef struct {
+    int32_t re;
+    int32_t im;
+} matrix_cresult_t;
+
+typedef matrix_complex_t matrix_cinput_t[MATRIX_SIZE][MATRIX_SIZE];
+typedef matrix_cresult_t matrix_coutput_t[MATRIX_SIZE][MATRIX_SIZE];
+
+/**
+ * @brief Strided batch descriptor
+ * 
+ * All addresses are byte offsets into the accelerator scratchpad. Item b
+ * multiplies the row-major 4x4 byte tiles at a_base + b*a_stride and
+ * b_base + b*b_stride and stores the row-major 32-bit result tile at
+ * c_base + b*c_stride.
+ */
+typedef struct {
+    uint32_t batch_count;
+    uint32_t a_base;
+    uint32_t b_base;
+    uint32_t c_base;
+    uint32_t a_stride;
+    uint32_t b_stride;
+    uint32_t c_stride;
+} matrix_accel_batch_desc_t;
+
+/**
+ * @brief Pooling descriptor
+ * 
+ * Pools a height x width x channels map of 32-bit elements (channels
+ * innermost) from the scratchpad into an out_h x out_w x channels map,
+ * out = (in - window) / stride + 1. Bases are scratchpad byte offsets; the
+ * output may overwrite the input when dst <= src.
+ */
+typedef struct {
+    uint32_t src;
+    uint32_t dst;
+    uint16_t height;
+    uint16_t width;
+    uint16_t channels;
+    uint8_t  window;    // 2 or 3
+    uint8_t  stride;    // 1 to 15
+    bool     average;   // false = max, true = average (truncated)
+} matrix_accel_pool_desc_t;
+
+/**
+ * @brief LayerNorm / RMSNorm descriptor
+ * 
+ * Normalizes rows x len 32-bit elements (row-major) from the scratchpad.
+ * params holds one NORM_PARAM(gamma, beta) word per column. Bases are
+ * scratchpad byte offsets; dst may equal src.
+ */
+typedef struct {
+    uint32_t src;
+    uint32_t dst;
+    uint32_t params;
+    uint16_t rows;
+    uint16_t len;       // At least 2
+    uint32_t eps;       // Added to the variance, in squared input units
+    bool     rms;       // false = LayerNorm, true = RMSNorm
+} matrix_accel_norm_desc_t;
+
+/**
+ * @brief Large GEMM descriptor
+ * 
+ * Computes C[m x p] = A[m x n] * B[n x p] entirely from the scratchpad.
+ * A and B are row-major 8-bit matrices, C is row-major 32-bit. Bases are
+ * scratchpad byte offsets and leading dimensions are row pitches in bytes.
+ */
+typedef struct {
+    uint16_t m;
+    uint16_t n;
+    uint16_t p;
+    uint32_t a_base;
+    uint32_t b_base;
+    uint32_t c_base;
+    uint16_t lda;
+    uint16_t ldb;
+    uint16_t ldc;
+} matrix_accel_gemm_desc_t;
+
 /**
  * @brief Initialize the matrix accelerator
  * 
@@ -81,7 +194,8 @@ matrix_accel_result_t matrix_accel_load_matrices(const matrix_input_t matrix_a,
  * @brief Start matrix multiplication operation
  * 
  * Triggers the accelerator to begin computation.
- * Matrices must be loaded first.
+ * Matrices must be loaded first. If a job is already running the start is
+ * queued and begins as soon as the running job writes its last result.
  * 
  * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
  */
@@ -94,6 +208,24 @@ matrix_accel_result_t matrix_accel_start(void);
  */
 matrix_accel_result_t matrix_accel_wait_done(uint32_t timeout_cycles);
 
+/**
+ * @brief Wait until the completed job counter reaches a value
+ * 
+ * Use with matrix_accel_get_job_count() to track individual jobs when
+ * starts are queued back-to-back.
+ * 
+ * @param job_count Counter value to wait for
+ * @param timeout_cycles Maximum cycles to wait (0 = no timeout)
+ * @return MATRIX_ACCEL_SUCCESS on success, MATRIX_ACCEL_ERROR_TIMEOUT on timeout
+ */
+matrix_accel_result_t matrix_accel_wait_jobs(uint32_t job_count, uint32_t timeout_cycles);
+
+/**
+ * @brief Get the number of jobs completed since the last reset
+ * @return Completed job counter
+ */
+uint32_t matrix_accel_get_job_count(void);
+
 /**
  * @brief Read result matrix from accelerator
  * @param result Pointer to output matrix buffer
@@ -101,11 +233,33 @@ matrix_accel_result_t matrix_accel_wait_done(uint32_t timeout_cycles);
  */
 matrix_accel_result_t matrix_accel_read_result(matrix_output_t result);
 
+/**
+ * @brief Wait until one row of the result matrix has been written
+ * 
+ * Rows complete in order while the rest of the job is still computing,
+ * so read-back of early rows can overlap with compute of later ones.
+ * 
+ * @param row Result row index (0 to MATRIX_SIZE-1)
+ * @param timeout_cycles Maximum cycles to wait (0 = no timeout)
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_wait_row(int row, uint32_t timeout_cycles);
+
+/**
+ * @brief Read one finished row of the result matrix
+ * @param row Result row index (0 to MATRIX_SIZE-1)
+ * @param result Output buffer for MATRIX_SIZE elements
+ * @return MATRIX_ACCEL_SUCCESS on success, MATRIX_ACCEL_ERROR_BUSY if the
+ *         row is not ready yet
+ */
+matrix_accel_result_t matrix_accel_read_row(int row, matrix_result_t result[MATRIX_SIZE]);
+
 /**
  * @brief Perform complete matrix multiplication operation
  * 
  * High-level function that performs the entire operation:
- * load matrices, start computation, wait for completion, read results.
+ * load matrices, start computation, then read each result row as soon
+ * as the accelerator reports it finished.
  * 
  * @param matrix_a Input matrix A
  * @param matrix_b Input matrix B
@@ -118,6 +272,577 @@ matrix_accel_result_t matrix_accel_multiply(const matrix_input_t matrix_a,
                                              matrix_output_t result,
                                              uint32_t timeout_cycles);
 
+/**
+ * @brief Multiply matrices in place in system RAM
+ * 
+ * The accelerator reads A and B and writes C directly at the given
+ * addresses through its RAM port, so nothing is copied through the
+ * register window. All three buffers must live in RAM (not in ROM
+ * constants) and the result must be word aligned.
+ * 
+ * @param matrix_a Input matrix A
+ * @param matrix_b Input matrix B (row-major)
+ * @param result Output matrix C (A * B)
+ * @param timeout_cycles Maximum cycles to wait for completion
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_multiply_inplace(const matrix_input_t matrix_a,
+                                                    const matrix_input_t matrix_b,
+                                                    matrix_output_t result,
+                                                    uint32_t timeout_cycles);
+
+/**
+ * @brief Sparse matrix-vector product y = A * x
+ * 
+ * The SpMV unit walks the CSR arrays in RAM, gathers the x element of each
+ * nonzero and accumulates on its own PE, so only nonzeros cost time. The
+ * CPU just programs the descriptor and waits.
+ * 
+ * @param matrix CSR matrix (arrays in system RAM)
+ * @param x Input vector, matrix->cols entries (system RAM)
+ * @param y Output vector, matrix->rows entries (system RAM, word aligned)
+ * @param timeout_cycles Maximum cycles to wait for completion
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_spmv_csr(const matrix_accel_csr_t* matrix, const int8_t* x,
+                                            int32_t* y, uint32_t timeout_cycles);
+
+/**
+ * @brief Complex matrix multiplication
+ * 
+ * Each operand element goes over the bus as one packed (re, im) word and
+ * the PE accumulates complex products directly, so a complex product costs
+ * one job instead of four real ones.
+ * 
+ * @param matrix_a Input matrix A
+ * @param matrix_b Input matrix B
+ * @param result Output matrix C (A * B)
+ * @param timeout_cycles Maximum cycles to wait for completion
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_cgemm(const matrix_cinput_t matrix_a,
+                                         const matrix_cinput_t matrix_b,
+                                         matrix_coutput_t result,
+                                         uint32_t timeout_cycles);
+
+/**
+ * @brief Read the per-bank RAM conflict counters
+ * 
+ * A conflict is a cycle in which the CPU and the accelerator addressed the
+ * same RAM bank and one of them had to wait.
+ * 
+ * @param counts Output buffer, one counter per bank
+ */
+void matrix_accel_get_ram_conflicts(uint32_t counts[SYSTEM_RAM_BANKS]);
+
+/**
+ * @brief Reset the RAM conflict counters
+ */
+void matrix_accel_clear_ram_conflicts(void);
+
+/**
+ * @brief Enable or disable row-streaming mode
+ * 
+ * In streaming mode matrix B stays resident and writing the last element of
+ * an A row immediately computes the matching C row, so rows can be fed
+ * continuously without a start command.
+ * 
+ * @param enable true to enable streaming, false for whole-matrix jobs
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_set_stream_mode(bool enable);
+
+/**
+ * @brief Select the operation every following job computes
+ * 
+ * Results start from the additive identity of the semiring (INT32_MAX for
+ * PE_OP_MINPLUS, INT32_MIN for PE_OP_MAXPLUS, 0 otherwise), and large GEMM
+ * edge tiles are padded so the padding never changes a result. Cached B
+ * tiles are dropped, since their padding depends on the operation.
+ * 
+ * @param op PE_OP_MAC (default), PE_OP_GF, PE_OP_MINPLUS, PE_OP_MAXPLUS,
+ *           PE_OP_BOOL, PE_OP_XNOR, PE_OP_L1 or PE_OP_L2
+ * @return MATRIX_ACCEL_SUCCESS on success, MATRIX_ACCEL_ERROR_INVALID_PARAM
+ *         for an unknown operation
+ */
+matrix_accel_result_t matrix_accel_set_pe_op(uint32_t op);
+
+/**
+ * @brief Write one row of matrix A in streaming mode
+ * 
+ * The row is queued for computation as soon as its last element lands.
+ * The result is available through matrix_accel_wait_row() and
+ * matrix_accel_read_row().
+ * 
+ * @param row Row index (0 to MATRIX_SIZE-1)
+ * @param a_row Row of MATRIX_SIZE input elements
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_stream_write_row(int row, const matrix_element_t a_row[MATRIX_SIZE]);
+
+/**
+ * @brief Stream a full A matrix through the row pipeline
+ * 
+ * Writes every row of A, then reads each C row back as it completes, so
+ * compute of row r overlaps the transfer of row r+1. Streaming mode must
+ * be enabled and matrix B loaded beforehand.
+ * 
+ * @param matrix_a Input matrix A
+ * @param result Output matrix C (A * B)
+ * @param timeout_cycles Maximum cycles to wait per row
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_stream_frame(const matrix_input_t matrix_a,
+                                                 matrix_output_t result,
+                                                 uint32_t timeout_cycles);
+
+/**
+ * @brief Copy data into the accelerator scratchpad
+ * @param offset Byte offset into the scratchpad (word aligned)
+ * @param data Source buffer
+ * @param bytes Number of bytes to copy (multiple of 4)
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_scratch_write(uint32_t offset, const void* data, uint32_t bytes);
+
+/**
+ * @brief Copy data out of the accelerator scratchpad
+ * @param offset Byte offset into the scratchpad (word aligned)
+ * @param data Destination buffer
+ * @param bytes Number of bytes to copy (multiple of 4)
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_scratch_read(uint32_t offset, void* data, uint32_t bytes);
+
+/**
+ * @brief Start a strided batch of multiplications
+ * 
+ * The accelerator walks the whole batch without CPU involvement; use
+ * matrix_accel_wait_done() to wait for the last result tile to be stored.
+ * 
+ * @param desc Batch descriptor
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_batch_start(const matrix_accel_batch_desc_t* desc);
+
+/**
+ * @brief Start a large GEMM walked tile by tile in hardware
+ * 
+ * The accelerator iterates all output tiles, including partial edge tiles,
+ * and accumulates over the inner dimension itself; use
+ * matrix_accel_wait_done() to wait for the whole product.
+ * 
+ * @param desc GEMM descriptor
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_gemm_start(const matrix_accel_gemm_desc_t* desc);
+
+/**
+ * @brief Start pooling a result map held in the scratchpad
+ * 
+ * Typically follows a large GEMM or sequencer layer whose results are still
+ * in the scratchpad, so only the pooled map has to be read back. Use
+ * matrix_accel_wait_done() to wait for it.
+ * 
+ * @param desc Pooling descriptor
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_pool_start(const matrix_accel_pool_desc_t* desc);
+
+/**
+ * @brief Upload a sequencer program
+ * 
+ * Programs are built with the SEQ_* instruction macros from
+ * matrix_accel_hal.h and may not be uploaded while the accelerator is busy.
+ * 
+ * @param program Encoded instructions
+ * @param count Number of instructions (at most SEQ_IMEM_WORDS)
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_seq_load(const uint32_t* program, uint32_t count);
+
+/**
+ * @brief Start the uploaded sequencer program
+ * 
+ * The program runs until END; use matrix_accel_wait_done() to wait for it.
+ * 
+ * @param entry_pc Instruction index to start from
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_seq_start(uint32_t entry_pc);
+
+/**
+ * @brief Release one WAIT instruction of the running program
+ * 
+ * Signals sent before the program reaches WAIT are remembered.
+ */
+void matrix_accel_seq_signal(void);
+
+/**
+ * @brief Retire every cached B tile
+ * 
+ * B tiles loaded from the scratchpad stay resident and later loads from the
+ * same address are skipped. Call this after rewriting weights in the
+ * scratchpad so stale tiles are not reused.
+ */
+void matrix_accel_bcache_invalidate(void);
+
+/**
+ * @brief Read the B tile cache counters
+ * @param hits Loads served from a resident tile (may be NULL)
+ * @param misses Loads copied from the scratchpad (may be NULL)
+ */
+void matrix_accel_bcache_get_stats(uint32_t* hits, uint32_t* misses);
+
+/**
+ * @brief Reset the B tile cache counters
+ */
+void matrix_accel_bcache_clear_stats(void);
+
+/**
+ * @brief Compress bytes into a zero-run-length stream
+ * 
+ * Produces the token format read by SEQ_LDAZ and written by SEQ_STCZ:
+ * 0x80|n is a run of n+1 zeros, n is followed by n+1 literal bytes.
+ * 
+ * @param src Input bytes
+ * @param count Number of input bytes
+ * @param dst Output stream
+ * @param capacity Size of dst in bytes
+ * @return Stream length in bytes, or 0 if it does not fit
+ */
+uint32_t matrix_accel_rle_encode(const uint8_t* src, uint32_t count, uint8_t* dst, uint32_t capacity);
+
+/**
+ * @brief Expand a zero-run-length stream
+ * @param src Input stream
+ * @param length Stream length in bytes
+ * @param dst Output bytes
+ * @param count Number of bytes to produce
+ * @return MATRIX_ACCEL_SUCCESS, or MATRIX_ACCEL_ERROR_INVALID_PARAM if the
+ *         stream is truncated or overruns count
+ */
+matrix_accel_result_t matrix_accel_rle_decode(const uint8_t* src, uint32_t length, uint8_t* dst, uint32_t count);
+
+/**
+ * @brief Length of the last compressed C store (SEQ_STCZ)
+ * @return Stream length in bytes
+ */
+uint32_t matrix_accel_get_rle_len(void);
+
+/**
+ * @brief CRC-32 of result elements, as computed by the result signature
+ * 
+ * Each element counts as four little-endian bytes; the CRC is the zlib
+ * one, so pass 0 to start and a previous return value to continue.
+ * 
+ * @param crc CRC of the elements so far
+ * @param data Result elements in the order the accelerator writes them
+ *             (row-major)
+ * @param count Number of elements
+ * @return Updated CRC
+ */
+uint32_t matrix_accel_crc32(uint32_t crc, const matrix_result_t* data, uint32_t count);
+
+/**
+ * @brief Read the hardware result signatures
+ * 
+ * Lets stress tests validate results without reading matrix C back.
+ * 
+ * @param job_crc CRC of the last completed job (may be NULL)
+ * @param run_crc CRC of every result written since the last clear (may be NULL)
+ */
+void matrix_accel_get_result_crc(uint32_t* job_crc, uint32_t* run_crc);
+
+/**
+ * @brief Restart the running result signature
+ */
+void matrix_accel_clear_result_crc(void);
+
+/**
+ * @brief 3x3 convolution as im2col GEMM on the large GEMM walker
+ * 
+ * Computes the valid correlation output[y][x] = sum kernel[i][j] *
+ * input[y+i][x+j] for a single channel. Output is (height-2) x (width-2),
+ * row-major. Uses the scratchpad and the B tile cache.
+ * 
+ * @param input Row-major input image
+ * @param height Input rows (at least 3)
+ * @param width Input columns (at least 3)
+ * @param kernel 3x3 filter
+ * @param output Result image
+ * @param timeout_cycles Maximum cycles to wait for each chunk
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_conv3x3_direct(const int8_t* input, int height, int width,
+                                                  const int8_t kernel[3][3], int32_t* output,
+                                                  uint32_t timeout_cycles);
+
+/**
+ * @brief 3x3 convolution with Winograd F(2x2,3x3)
+ * 
+ * Same result as matrix_accel_conv3x3_direct(), with 16 multiplies per 2x2
+ * output tile instead of 36. The driver transforms the filter and each 4x4
+ * input tile, the sequencer runs the element-wise products (SEQ_ELT_MUL)
+ * over batches of tiles, and the driver applies the output transform.
+ * 
+ * Transformed operands must fit the 8-bit datapath, so input values are
+ * limited to +/-WINOGRAD_INPUT_MAX and the transformed filter (4x scaled)
+ * must stay within int8; other operands need the direct path.
+ * 
+ * @return MATRIX_ACCEL_SUCCESS on success, MATRIX_ACCEL_ERROR_INVALID_PARAM
+ *         if the operands are out of range, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_conv3x3_winograd(const int8_t* input, int height, int width,
+                                                    const int8_t kernel[3][3], int32_t* output,
+                                                    uint32_t timeout_cycles);
+
+/**
+ * @brief Multiply two GF(2^8) elements on the host
+ * @param a First element
+ * @param b Second element
+ * @param poly Low byte of the reduction polynomial (x^8 is implied)
+ * @return Product, as the PE computes it in PE_OP_GF mode
+ */
+uint8_t matrix_accel_gf_mul(uint8_t a, uint8_t b, uint8_t poly);
+
+/**
+ * @brief Erasure-encode data blocks over GF(2^8)
+ * 
+ * Computes parity[r][i] = sum_d coding[r][d] * data[d][i], with GF(2^8)
+ * multiplies and XOR sums, by running the large GEMM walker in PE_OP_GF
+ * mode over chunks of the blocks. With a Vandermonde or Cauchy coding
+ * matrix this is Reed-Solomon encoding. Uses the scratchpad and leaves
+ * the polynomial register set to poly.
+ * 
+ * @param coding Row-major parity_blocks x data_blocks coding matrix
+ * @param parity_blocks Number of parity blocks (1 to GF_MAX_BLOCKS)
+ * @param data Data blocks
+ * @param data_blocks Number of data blocks (1 to GF_MAX_BLOCKS)
+ * @param parity Parity block outputs
+ * @param block_len Bytes per block (multiple of 4)
+ * @param poly Low byte of the reduction polynomial (GF_POLY_DEFAULT for the
+ *             usual Reed-Solomon field)
+ * @param timeout_cycles Maximum cycles to wait for each chunk
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_gf_encode(const uint8_t* coding, int parity_blocks,
+                                             const uint8_t* const data[], int data_blocks,
+                                             uint8_t* const parity[], uint32_t block_len,
+                                             uint8_t poly, uint32_t timeout_cycles);
+
+/**
+ * @brief Binarized matrix product with the XNOR-popcount PE operation
+ * 
+ * Operands are +/-1 values packed one per bit (1 = +1, 0 = -1), element
+ * 32 * w + t in bit t of word w. Computes result[i][j] = sum over the
+ * k_words * 32 elements of a[i][k] * b[k][j], i.e. 2 * (matching bits) -
+ * 32 * k_words. Each PE step covers one 32-bit word, so the product runs
+ * on the large GEMM walker at 32 binary MACs per step.
+ * 
+ * @param a_bits Row-major m x k_words words, one bit row of A per row
+ * @param b_bits Columns of B as p x k_words words (B transposed, the usual
+ *               layout of binarized weights)
+ * @param m Rows of A and result
+ * @param p Columns of B and result
+ * @param k_words Inner dimension in 32-bit words
+ * @param result Row-major m x p results
+ * @param timeout_cycles Maximum cycles to wait
+ * @return MATRIX_ACCEL_SUCCESS on success, MATRIX_ACCEL_ERROR_INVALID_PARAM
+ *         if the operands do not fit the scratchpad, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_binary_gemm(const uint32_t* a_bits, const uint32_t* b_bits,
+                                               int m, int p, int k_words, int32_t* result,
+                                               uint32_t timeout_cycles);
+
+/**
+ * @brief Distances between every query and reference vector
+ * 
+ * Runs the large GEMM walker with the PE in PE_OP_L1 (sum of |q - r|) or
+ * PE_OP_L2 (sum of (q - r)^2, squared Euclidean) mode over chunks of the
+ * query and reference sets. With min_dist the nearest reference of every
+ * query is tracked as chunks come back, so kNN and k-means assignment can
+ * skip the full distance matrix by passing dist = NULL.
+ * 
+ * @param queries Row-major num_queries x dim vectors
+ * @param num_queries Number of queries
+ * @param refs Row-major num_refs x dim vectors
+ * @param num_refs Number of references
+ * @param dim Vector length (1 to DIST_MAX_DIM)
+ * @param metric PE_OP_L1 or PE_OP_L2
+ * @param dist Row-major num_queries x num_refs distances (may be NULL)
+ * @param min_dist Smallest distance per query (may be NULL)
+ * @param argmin Index of the nearest reference per query, lowest on ties
+ *               (may be NULL; needs min_dist)
+ * @param timeout_cycles Maximum cycles to wait for each chunk
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_pairwise_dist(const int8_t* queries, int num_queries,
+                                                 const int8_t* refs, int num_refs, int dim,
+                                                 uint32_t metric, int32_t* dist,
+                                                 int32_t* min_dist, int* argmin,
+                                                 uint32_t timeout_cycles);
+
+/**
+ * @brief 3x3 depthwise convolution
+ * 
+ * output[y][x][c] = sum weights[c][i][j] * input[y*stride+i][x*stride+j][c],
+ * valid padding, with no reduction across channels. Channels are taken 16
+ * at a time, one per element of a 4x4 tile, and a sequencer program runs
+ * the nine taps of every output pixel as element-wise products
+ * (SEQ_ELT_MUL, then SEQ_ELT_MAC) against per-channel weight tiles. Tall
+ * images are processed in strips of output rows.
+ * 
+ * @param input Input image, height x width x channels (channels innermost)
+ * @param height Input rows (at least 3)
+ * @param width Input columns (3 to DWCONV_MAX_WIDTH)
+ * @param channels Number of channels
+ * @param weights Per-channel filters, channels x 3 x 3
+ * @param stride 1 or 2
+ * @param output Result, out_h x out_w x channels with
+ *               out = (in - 3) / stride + 1
+ * @param timeout_cycles Maximum cycles to wait for each strip
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_dwconv2d(const int8_t* input, int height, int width,
+                                            int channels, const int8_t* weights, int stride,
+                                            int32_t* output, uint32_t timeout_cycles);
+
+/**
+ * @brief Row-wise softmax of the current result matrix
+ * 
+ * Runs on the result of the last job, in place: each row of C becomes
+ * softmax((c - max) / 2^shift / 8), computed with an exp() lookup table
+ * and a reciprocal of the row sum. Results are unsigned Q0.7
+ * probabilities (SOFTMAX_ONE = 1.0, saturated to 127), each within one
+ * step of the exact value, and stay in C for further use.
+ * 
+ * @param shift Logit scale, 0 to SOFTMAX_MAX_SHIFT
+ * @param probs Probabilities, or NULL to leave them only in C
+ * @param timeout_cycles Maximum cycles to wait
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_softmax(uint32_t shift, uint8_t probs[MATRIX_SIZE][MATRIX_SIZE],
+                                           uint32_t timeout_cycles);
+
+/**
+ * @brief LayerNorm or RMSNorm of scratchpad rows
+ * 
+ * Each row becomes y = round(z * gamma) + beta with
+ * z = (x - mean) / sqrt(var + eps) for LayerNorm and
+ * z = x / sqrt(mean(x^2) + eps) for RMSNorm. Row statistics are
+ * accumulated in hardware, the mean is rounded down to an integer and
+ * 1/sqrt comes from a lookup table accurate to 2%, so rows should span
+ * well over one input unit. Typically follows a large GEMM whose results
+ * are still in the scratchpad; |x - mean| must stay below 2^23.
+ * 
+ * @param desc Normalization descriptor
+ * @param timeout_cycles Maximum cycles to wait
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_layernorm(const matrix_accel_norm_desc_t* desc,
+                                             uint32_t timeout_cycles);
+
+/**
+ * @brief Fused single-head attention on 4x4 tiles
+ * 
+ * Computes softmax(Q * K^T) * V with one load and one read-back: the
+ * accelerator runs Q * K^T on the core, the row softmax of the scores
+ * (as matrix_accel_softmax() with the given shift) and the product of
+ * the probabilities with V, without returning to the CPU in between.
+ * Results are in units of 1/SOFTMAX_ONE and signed. Afterwards A holds
+ * the probabilities and B holds V. Refused while chain OUT_EN is set,
+ * since the intermediate scores would be forwarded downstream.
+ * 
+ * @param q Queries, one per row (signed 8-bit)
+ * @param k Keys, one per row (signed 8-bit)
+ * @param v Values, one per row (signed 8-bit)
+ * @param shift Logit scale for the softmax, 0 to SOFTMAX_MAX_SHIFT
+ * @param result Attention output times SOFTMAX_ONE
+ * @param timeout_cycles Maximum cycles to wait
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_attention(const matrix_input_t q, const matrix_input_t k,
+                                             const matrix_input_t v, uint32_t shift,
+                                             matrix_output_t result, uint32_t timeout_cycles);
+
+/**
+ * @brief Load matrix B into one accelerator unit
+ * @param unit Unit index (0 to MATRIX_ACCEL_NUM_UNITS-1)
+ * @param matrix Input matrix B (row-major)
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_unit_load_matrix_b(int unit, const matrix_input_t matrix);
+
+/**
+ * @brief Load the same matrix B into several units at once
+ * 
+ * Uses the multicast window, so the bus carries each element once however
+ * many units share the weights.
+ * 
+ * @param unit_mask Bit n selects unit n
+ * @param matrix Input matrix B (row-major)
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_bcast_load_matrix_b(uint32_t unit_mask, const matrix_input_t matrix);
+
+/**
+ * @brief Configure the result-forwarding links of one unit
+ * 
+ * A forwarding unit passes every C element it computes, shifted right by
+ * out_shift and saturated to 8 bits, to the next unit, whose A matrix fills
+ * row by row and computes each row as soon as it is complete.
+ * 
+ * @param unit Unit index (0 to MATRIX_ACCEL_NUM_UNITS-1)
+ * @param forward_out Forward results to unit+1
+ * @param accept_in Take A operands from unit-1
+ * @param out_shift Requantization shift applied to forwarded results
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_chain_config(int unit, bool forward_out, bool accept_in,
+                                                uint32_t out_shift);
+
+/**
+ * @brief Wait for and read one finished result row of a unit
+ * @param unit Unit index (0 to MATRIX_ACCEL_NUM_UNITS-1)
+ * @param row Result row index (0 to MATRIX_SIZE-1)
+ * @param result Output buffer for MATRIX_SIZE elements
+ * @param timeout_cycles Maximum cycles to wait (0 = no timeout)
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_unit_read_row(int unit, int row,
+                                                 matrix_result_t result[MATRIX_SIZE],
+                                                 uint32_t timeout_cycles);
+
+/**
+ * @brief Set up a layer pipeline across the first num_units units
+ * 
+ * Unit n holds the weights of layer n and forwards its results to unit
+ * n+1; unit 0 is switched to row streaming so the CPU only feeds it.
+ * 
+ * @param num_units Pipeline depth (1 to MATRIX_ACCEL_NUM_UNITS)
+ * @param weights Weight matrix of each layer
+ * @param shift Requantization shift between layers
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_chain_setup(int num_units, const matrix_input_t weights[],
+                                               uint32_t shift);
+
+/**
+ * @brief Push one input through the layer pipeline
+ * 
+ * Streams A into unit 0 and reads the output of the last layer. Rows move
+ * between units without CPU involvement.
+ * 
+ * @param num_units Pipeline depth used in matrix_accel_chain_setup()
+ * @param matrix_a Input to the first layer
+ * @param result Output of the last layer
+ * @param timeout_cycles Maximum cycles to wait per row
+ * @return MATRIX_ACCEL_SUCCESS on success, error code otherwise
+ */
+matrix_accel_result_t matrix_accel_chain_frame(int num_units, const matrix_input_t matrix_a,
+                                               matrix_output_t result, uint32_t timeout_cycles);
+
 /**
  * @brief Reset the accelerator
  * 
@@ -6,13 +6,59 @@
  * matrix multiplication accelerator. It defines register addresses, bit fields,
  * and basic read/write operations.
  * 
- * Memory Map:
- * 0x10000000: CONTROL   [bit 0: start, bit 1: reset]
- * 0x10000004: STATUS    [bit 0: done, bit 1: busy] 
- * 0x10000008: CONFIG    [matrix dimensions]
- * 0x10000100: Matrix A  [4x4 matrix, 8-bit elements]
- * 0x10000200: Matrix B  [4x4 matrix, 8-bit elements]
- * 0x10000300: Matrix C  [4x4 matrix, 32-bit results]
+ * Memory Map (matches matrix_accel_wrapper.v):
+ * 0x10000000: Matrix A  [4x4 matrix, 8-bit elements, one per word]
+ * 0x10000040: Matrix B  [4x4 matrix, 8-bit elements, one per word,
+ *                        column-major: B[row][col] at index col*4+row]
+ * 0x10000080: Matrix C  [4x4 matrix, 32-bit results]
+ * 0x100000C0: ATTN_V    [4x4 attention value tile, same layout as B]
+ * 0x10000100: CONTROL   [bit 0: start, bit 1: reset, bit 2: batch start,
+ *                        bit 3: sequencer start, bit 4: large GEMM start,
+ *                        bit 5: CSR SpMV start, bit 6: pooling start,
+ *                        bit 7: softmax start, bit 8: normalization start,
+ *                        bit 9: fused attention start]
+ * 0x10000104: STATUS    [bit 0: busy, bit 1: done, bit 2: start pending,
+ *                        bits 15:8: C rows of the current job ready]
+ * 0x10000108: CONFIG    [bits 23:0: matrix dimensions, bit 24: row streaming,
+ *                        bit 25: started jobs use operands in RAM,
+ *                        bit 26: complex jobs, bits 29:27: PE operation]
+ * 0x1000010C: JOB_COUNT [completed jobs since reset, read-only]
+ * 0x10000110: BATCH     [7-word strided batch descriptor]
+ * 0x1000012C: SEQ_ENTRY [sequencer start PC]
+ * 0x10000130: SEQ_SIGNAL[sequencer doorbell, write-only]
+ * 0x10000134: SEQ_PC    [sequencer current PC, read-only]
+ * 0x10000138: CHAIN     [bit 0: forward C to next unit, bit 1: accept A from
+ *                        previous unit, bits 12:8: requantize shift,
+ *                        bits 31:24: forwarding FIFO level (read-only)]
+ * 0x1000013C: B_GEN     [B tile cache generation, bits 7:0]
+ * 0x10000140: GEMM      [9-word large GEMM descriptor]
+ * 0x10000170: B_HITS    [B tile cache hits, write clears]
+ * 0x10000174: B_MISSES  [B tile cache misses, write clears]
+ * 0x10000178: RLE_LEN   [bytes written by the last compressed C store, read-only]
+ * 0x10000180: RAM_DESC  [6-word in-place operand descriptor]
+ * 0x10000198: CRC_JOB   [CRC-32 of the last job's C writes, read-only]
+ * 0x1000019C: CRC_RUN   [running CRC-32 of all C writes, write clears]
+ * 0x100001A0: SPMV_DESC [6-word CSR SpMV descriptor]
+ * 0x100001B8: GF_POLY   [GF(2^8) reduction polynomial x^8 + bits 7:0]
+ * 0x100001BC: SOFTMAX   [softmax logit shift, bits 4:0]
+ * 0x100001C0: POOL_DESC [6-word scratchpad pooling descriptor]
+ * 0x100001D8: NORM_DESC [8-word LayerNorm/RMSNorm descriptor]
+ * 0x10000200: SEQ_IMEM  [64-word sequencer program]
+ * 0x10000300: CPLX_A    [complex A, bits 7:0 real, bits 15:8 imaginary]
+ * 0x10000340: CPLX_B    [complex B, same packing, column-major]
+ * 0x10000380: CPLX_C    [complex C, bits 15:0 real, bits 31:16 imaginary,
+ *                        saturated to int16, read-only]
+ * 0x100003C0: C_IMAG    [imaginary part of C, 32-bit, read-only]
+ * 0x10001000: SCRATCH   [4KB operand scratchpad]
+ *
+ * Unit n of MATRIX_ACCEL_NUM_UNITS repeats this map at
+ * MATRIX_ACCEL_BASE + n * MATRIX_ACCEL_UNIT_STRIDE. The same map at
+ * MATRIX_ACCEL_BCAST_BASE writes to every unit set in the broadcast mask
+ * (0x10102000, all units after reset) and reads from the lowest one.
+ *
+ * System RAM is split into SYSTEM_RAM_BANKS word-interleaved banks shared by
+ * the CPU and the accelerator; 0x10200000 holds one conflict counter per
+ * bank (any write clears them).
  */
 
 #ifndef MATRIX_ACCEL_HAL_H
@@ -23,29 +69,254 @@
 // Base address of matrix accelerator
 #define MATRIX_ACCEL_BASE       0x10000000UL
 
+// Accelerator units and the spacing of their register windows
+#define MATRIX_ACCEL_NUM_UNITS  2
+#define MATRIX_ACCEL_UNIT_STRIDE 0x00002000UL
+#define MATRIX_ACCEL_UNIT_BASE(n) (MATRIX_ACCEL_BASE + (uint32_t)(n) * MATRIX_ACCEL_UNIT_STRIDE)
+
+// Multicast window and its unit mask register
+#define MATRIX_ACCEL_BCAST_BASE 0x10100000UL
+#define BCAST_MASK_REG_ADDR     (MATRIX_ACCEL_BCAST_BASE + MATRIX_ACCEL_UNIT_STRIDE)
+#define BCAST_MASK_ALL          ((1U << MATRIX_ACCEL_NUM_UNITS) - 1)
+
 // Register offsets
-#define CONTROL_REG_OFFSET      0x00000000UL
-#define STATUS_REG_OFFSET       0x00000004UL
-#define CONFIG_REG_OFFSET       0x00000008UL
-#define MATRIX_A_BASE_OFFSET    0x00000100UL
-#define MATRIX_B_BASE_OFFSET    0x00000200UL
-#define MATRIX_C_BASE_OFFSET    0x00000300UL
+#define CONTROL_REG_OFFSET      0x00000100UL
+#define STATUS_REG_OFFSET       0x00000104UL
+#define CONFIG_REG_OFFSET       0x00000108UL
+#define JOB_COUNT_REG_OFFSET    0x0000010CUL
+#define BATCH_DESC_OFFSET       0x00000110UL
+#define SEQ_ENTRY_REG_OFFSET    0x0000012CUL
+#define SEQ_SIGNAL_REG_OFFSET   0x00000130UL
+#define SEQ_PC_REG_OFFSET       0x00000134UL
+#define CHAIN_CTRL_REG_OFFSET   0x00000138UL
+#define B_GEN_REG_OFFSET        0x0000013CUL
+#define B_HITS_REG_OFFSET       0x00000170UL
+#define B_MISSES_REG_OFFSET     0x00000174UL
+#define RLE_LEN_REG_OFFSET      0x00000178UL
+#define RAM_DESC_OFFSET         0x00000180UL
+#define CRC_JOB_REG_OFFSET      0x00000198UL
+#define CRC_RUN_REG_OFFSET      0x0000019CUL
+#define SPMV_DESC_OFFSET        0x000001A0UL
+#define GF_POLY_REG_OFFSET      0x000001B8UL
+#define SOFTMAX_CFG_REG_OFFSET  0x000001BCUL
+#define POOL_DESC_OFFSET        0x000001C0UL
+#define NORM_DESC_OFFSET        0x000001D8UL
+#define GEMM_DESC_OFFSET        0x00000140UL
+#define SEQ_IMEM_OFFSET         0x00000200UL
+#define SCRATCH_BASE_OFFSET     0x00001000UL
+#define MATRIX_A_BASE_OFFSET    0x00000000UL
+#define MATRIX_B_BASE_OFFSET    0x00000040UL
+#define MATRIX_C_BASE_OFFSET    0x00000080UL
+#define ATTN_V_BASE_OFFSET      0x000000C0UL
+#define CPLX_A_BASE_OFFSET      0x00000300UL
+#define CPLX_B_BASE_OFFSET      0x00000340UL
+#define CPLX_C_BASE_OFFSET      0x00000380UL
+#define C_IMAG_BASE_OFFSET      0x000003C0UL
 
 // Register addresses
 #define CONTROL_REG_ADDR        (MATRIX_ACCEL_BASE + CONTROL_REG_OFFSET)
 #define STATUS_REG_ADDR         (MATRIX_ACCEL_BASE + STATUS_REG_OFFSET)
 #define CONFIG_REG_ADDR         (MATRIX_ACCEL_BASE + CONFIG_REG_OFFSET)
+#define JOB_COUNT_REG_ADDR      (MATRIX_ACCEL_BASE + JOB_COUNT_REG_OFFSET)
+#define BATCH_DESC_ADDR         (MATRIX_ACCEL_BASE + BATCH_DESC_OFFSET)
+#define SEQ_ENTRY_REG_ADDR      (MATRIX_ACCEL_BASE + SEQ_ENTRY_REG_OFFSET)
+#define SEQ_SIGNAL_REG_ADDR     (MATRIX_ACCEL_BASE + SEQ_SIGNAL_REG_OFFSET)
+#define SEQ_PC_REG_ADDR         (MATRIX_ACCEL_BASE + SEQ_PC_REG_OFFSET)
+#define GEMM_DESC_ADDR          (MATRIX_ACCEL_BASE + GEMM_DESC_OFFSET)
+#define B_GEN_REG_ADDR          (MATRIX_ACCEL_BASE + B_GEN_REG_OFFSET)
+#define B_HITS_REG_ADDR         (MATRIX_ACCEL_BASE + B_HITS_REG_OFFSET)
+#define B_MISSES_REG_ADDR       (MATRIX_ACCEL_BASE + B_MISSES_REG_OFFSET)
+#define RLE_LEN_REG_ADDR        (MATRIX_ACCEL_BASE + RLE_LEN_REG_OFFSET)
+#define RAM_DESC_ADDR           (MATRIX_ACCEL_BASE + RAM_DESC_OFFSET)
+#define CRC_JOB_REG_ADDR        (MATRIX_ACCEL_BASE + CRC_JOB_REG_OFFSET)
+#define CRC_RUN_REG_ADDR        (MATRIX_ACCEL_BASE + CRC_RUN_REG_OFFSET)
+#define SPMV_DESC_ADDR          (MATRIX_ACCEL_BASE + SPMV_DESC_OFFSET)
+#define GF_POLY_REG_ADDR        (MATRIX_ACCEL_BASE + GF_POLY_REG_OFFSET)
+#define SOFTMAX_CFG_REG_ADDR    (MATRIX_ACCEL_BASE + SOFTMAX_CFG_REG_OFFSET)
+#define POOL_DESC_ADDR          (MATRIX_ACCEL_BASE + POOL_DESC_OFFSET)
+#define NORM_DESC_ADDR          (MATRIX_ACCEL_BASE + NORM_DESC_OFFSET)
+#define SEQ_IMEM_ADDR           (MATRIX_ACCEL_BASE + SEQ_IMEM_OFFSET)
+#define SCRATCH_BASE_ADDR       (MATRIX_ACCEL_BASE + SCRATCH_BASE_OFFSET)
 #define MATRIX_A_BASE_ADDR      (MATRIX_ACCEL_BASE + MATRIX_A_BASE_OFFSET)
 #define MATRIX_B_BASE_ADDR      (MATRIX_ACCEL_BASE + MATRIX_B_BASE_OFFSET)
 #define MATRIX_C_BASE_ADDR      (MATRIX_ACCEL_BASE + MATRIX_C_BASE_OFFSET)
+#define ATTN_V_BASE_ADDR        (MATRIX_ACCEL_BASE + ATTN_V_BASE_OFFSET)
+#define CPLX_A_BASE_ADDR        (MATRIX_ACCEL_BASE + CPLX_A_BASE_OFFSET)
+#define CPLX_B_BASE_ADDR        (MATRIX_ACCEL_BASE + CPLX_B_BASE_OFFSET)
+#define CPLX_C_BASE_ADDR        (MATRIX_ACCEL_BASE + CPLX_C_BASE_OFFSET)
+#define C_IMAG_BASE_ADDR        (MATRIX_ACCEL_BASE + C_IMAG_BASE_OFFSET)
 
 // Control register bit definitions
 #define CONTROL_START_BIT       (1 << 0)
 #define CONTROL_RESET_BIT       (1 << 1)
+#define CONTROL_BATCH_BIT       (1 << 2)
+#define CONTROL_SEQ_START_BIT   (1 << 3)
+#define CONTROL_GEMM_BIT        (1 << 4)
+#define CONTROL_SPMV_BIT        (1 << 5)
+#define CONTROL_POOL_BIT        (1 << 6)
+#define CONTROL_SOFTMAX_BIT     (1 << 7)
+#define CONTROL_NORM_BIT        (1 << 8)
+#define CONTROL_ATTN_BIT        (1 << 9)
 
 // Status register bit definitions
-#define STATUS_DONE_BIT         (1 << 0)
-#define STATUS_BUSY_BIT         (1 << 1)
+#define STATUS_BUSY_BIT         (1 << 0)
+#define STATUS_DONE_BIT         (1 << 1)
+#define STATUS_PENDING_BIT      (1 << 2)
+#define STATUS_ROW_VALID_SHIFT  8
+#define STATUS_ROW_VALID_MASK   (0xFF << STATUS_ROW_VALID_SHIFT)
+#define STATUS_ROW_VALID_BIT(r) (1 << (STATUS_ROW_VALID_SHIFT + (r)))
+
+// Chain control register bit definitions
+#define CHAIN_OUT_EN_BIT        (1 << 0)
+#define CHAIN_IN_EN_BIT         (1 << 1)
+#define CHAIN_SHIFT_SHIFT       8
+#define CHAIN_SHIFT_MASK        (0x1F << CHAIN_SHIFT_SHIFT)
+#define CHAIN_LEVEL_SHIFT       24
+
+// Batch descriptor word indices
+#define BATCH_DESC_COUNT        0
+#define BATCH_DESC_A_BASE       1
+#define BATCH_DESC_B_BASE       2
+#define BATCH_DESC_C_BASE       3
+#define BATCH_DESC_A_STRIDE     4
+#define BATCH_DESC_B_STRIDE     5
+#define BATCH_DESC_C_STRIDE     6
+
+// Large GEMM descriptor word indices (leading dimensions in bytes)
+#define GEMM_DESC_M             0
+#define GEMM_DESC_N             1
+#define GEMM_DESC_P             2
+#define GEMM_DESC_A_BASE        3
+#define GEMM_DESC_B_BASE        4
+#define GEMM_DESC_C_BASE        5
+#define GEMM_DESC_LDA           6
+#define GEMM_DESC_LDB           7
+#define GEMM_DESC_LDC           8
+
+// In-place operand descriptor word indices (RAM byte addresses, strides in bytes)
+#define RAM_DESC_A_ADDR         0
+#define RAM_DESC_B_ADDR         1
+#define RAM_DESC_C_ADDR         2
+#define RAM_DESC_LDA            3
+#define RAM_DESC_LDB            4
+#define RAM_DESC_LDC            5
+
+// CSR SpMV descriptor word indices (RAM byte addresses)
+#define SPMV_DESC_ROWS          0
+#define SPMV_DESC_ROW_PTR       1
+#define SPMV_DESC_COL_IDX       2
+#define SPMV_DESC_VALUES        3
+#define SPMV_DESC_X             4
+#define SPMV_DESC_Y             5
+
+// Pooling descriptor word indices (scratchpad byte offsets)
+#define POOL_DESC_SRC           0
+#define POOL_DESC_DST           1
+#define POOL_DESC_HEIGHT        2
+#define POOL_DESC_WIDTH         3
+#define POOL_DESC_CHANNELS      4
+#define POOL_DESC_MODE          5
+
+// POOL_DESC_MODE fields
+#define POOL_MODE(window, stride, avg) \
+    (((uint32_t)(window) & 0xF) | (((uint32_t)(stride) & 0xF) << 8) | ((avg) ? (1U << 16) : 0))
+
+// Normalization descriptor word indices (scratchpad byte offsets)
+#define NORM_DESC_SRC           0
+#define NORM_DESC_DST           1
+#define NORM_DESC_PARAMS        2
+#define NORM_DESC_ROWS          3
+#define NORM_DESC_LEN           4
+#define NORM_DESC_INV_LEN       5   // ceil(2^32 / len)
+#define NORM_DESC_EPS           6
+#define NORM_DESC_MODE          7
+
+// NORM_DESC_MODE fields
+#define NORM_MODE_RMS           (1U << 0)
+
+// Per-column normalization parameter word: gamma in Q8.8, integer beta
+#define NORM_PARAM(gamma, beta) \
+    (((uint32_t)(uint16_t)(gamma)) | ((uint32_t)(uint16_t)(beta) << 16))
+#define NORM_GAMMA_ONE          256
+
+// System RAM reachable by the accelerator's RAM port
+#define SYSTEM_RAM_BASE         0x80004000UL
+#define SYSTEM_RAM_SIZE_BYTES   16384
+#define SYSTEM_RAM_BANKS        4
+#define RAM_STATS_BASE_ADDR     0x10200000UL
+
+// Scratchpad size in bytes
+#define SCRATCH_SIZE_BYTES      4096
+
+// Sequencer program size in instructions
+#define SEQ_IMEM_WORDS          64
+
+// Sequencer instruction encoding: [31:28] opcode, [25:24] register, [15:0] imm
+#define SEQ_OP_END              0x0
+#define SEQ_OP_SETA             0x1
+#define SEQ_OP_ADDA             0x2
+#define SEQ_OP_LDA              0x3
+#define SEQ_OP_LDB              0x4
+#define SEQ_OP_GEMM             0x5
+#define SEQ_OP_GEMMA            0x6
+#define SEQ_OP_ELT              0x7
+#define SEQ_OP_STC              0x8
+#define SEQ_OP_SETC             0x9
+#define SEQ_OP_LOOP             0xA
+#define SEQ_OP_WAIT             0xB
+#define SEQ_OP_LDAZ             0xC
+#define SEQ_OP_STCZ             0xD
+
+#define SEQ_INSN(op, reg, imm)  (((uint32_t)(op) << 28) | (((uint32_t)(reg) & 3) << 24) | ((uint32_t)(imm) & 0xFFFF))
+#define SEQ_END()               SEQ_INSN(SEQ_OP_END, 0, 0)
+#define SEQ_SETA(ra, imm)       SEQ_INSN(SEQ_OP_SETA, ra, imm)
+#define SEQ_ADDA(ra, imm)       SEQ_INSN(SEQ_OP_ADDA, ra, imm)
+#define SEQ_LDA(ra, ld)         SEQ_INSN(SEQ_OP_LDA, ra, ld)
+#define SEQ_LDB(ra, ld)         SEQ_INSN(SEQ_OP_LDB, ra, ld)
+#define SEQ_GEMM()              SEQ_INSN(SEQ_OP_GEMM, 0, 0)
+#define SEQ_GEMMA()             SEQ_INSN(SEQ_OP_GEMMA, 0, 0)
+#define SEQ_ELT(fn)             SEQ_INSN(SEQ_OP_ELT, 0, fn)
+#define SEQ_STC(ra, ld)         SEQ_INSN(SEQ_OP_STC, ra, ld)
+#define SEQ_SETC(rc, imm)       SEQ_INSN(SEQ_OP_SETC, rc, imm)
+#define SEQ_LOOP(rc, pc)        SEQ_INSN(SEQ_OP_LOOP, rc, pc)
+#define SEQ_WAIT()              SEQ_INSN(SEQ_OP_WAIT, 0, 0)
+#define SEQ_LDAZ(ra)            SEQ_INSN(SEQ_OP_LDAZ, ra, 0)
+#define SEQ_STCZ(ra, shift)     SEQ_INSN(SEQ_OP_STCZ, ra, (shift) & 0x1F)
+
+// Zero-run-length stream tokens (LDAZ/STCZ): a run token covers up to
+// RLE_MAX_RUN zeros, a literal token is followed by up to RLE_MAX_RUN bytes
+#define RLE_ZERO_RUN_BIT        0x80
+#define RLE_MAX_RUN             128
+
+// Element-wise functions for SEQ_ELT
+#define SEQ_ELT_RELU            0x0
+#define SEQ_ELT_SRA(shift)      (0x1 | (((shift) & 0x1F) << 8))
+#define SEQ_ELT_MUL             0x2     // C = A (.) B
+#define SEQ_ELT_MAC             0x3     // C = C + A (.) B
+
+// Config register bit definitions
+#define CONFIG_STREAM_EN_BIT    (1 << 24)
+#define CONFIG_RAM_DIRECT_BIT   (1 << 25)
+#define CONFIG_COMPLEX_BIT      (1 << 26)
+#define CONFIG_PE_OP_SHIFT      27
+#define CONFIG_PE_OP_MASK       (0x7 << CONFIG_PE_OP_SHIFT)
+
+// PE operations (CONFIG bits 29:27)
+#define PE_OP_MAC               0x0     // c + a * b
+#define PE_OP_GF                0x1     // c ^ a * b in GF(2^8), low byte
+#define PE_OP_MINPLUS           0x2     // min(c, a + b)
+#define PE_OP_MAXPLUS           0x3     // max(c, a + b)
+#define PE_OP_BOOL              0x4     // c | (a & b), bitwise
+#define PE_OP_XNOR              0x5     // c + (+/-1 dot product of 32 packed bits)
+#define PE_OP_L1                0x6     // c + |a - b|
+#define PE_OP_L2                0x7     // c + (a - b)^2
+
+// Reduction polynomial after reset: x^8 + x^4 + x^3 + x^2 + 1
+#define GF_POLY_DEFAULT         0x1D
+
+// Softmax results are unsigned Q0.7 probabilities
+#define SOFTMAX_ONE             128
+#define SOFTMAX_MAX_SHIFT       31
 
 // Matrix dimensions (fixed for this implementation)
 #define MATRIX_SIZE             4
@@ -113,6 +384,260 @@ static inline void hal_write_config(uint32_t value) {
     hal_write_reg32((volatile uint32_t*)CONFIG_REG_ADDR, value);
 }
 
+/**
+ * @brief Read completed job counter
+ * @return Number of jobs finished since the last reset
+ */
+static inline uint32_t hal_read_job_count(void) {
+    return hal_read_reg32((volatile uint32_t*)JOB_COUNT_REG_ADDR);
+}
+
+/**
+ * @brief Write one word of the batch descriptor
+ * @param index Descriptor word index (BATCH_DESC_*)
+ * @param value Word value
+ */
+static inline void hal_write_batch_desc(int index, uint32_t value) {
+    hal_write_reg32((volatile uint32_t*)(BATCH_DESC_ADDR + (index * 4)), value);
+}
+
+/**
+ * @brief Write a word of the scratchpad
+ * @param offset Byte offset into the scratchpad (word aligned)
+ * @param value Word value
+ */
+static inline void hal_write_scratch_word(uint32_t offset, uint32_t value) {
+    hal_write_reg32((volatile uint32_t*)(SCRATCH_BASE_ADDR + offset), value);
+}
+
+/**
+ * @brief Read a word of the scratchpad
+ * @param offset Byte offset into the scratchpad (word aligned)
+ * @return Word value
+ */
+static inline uint32_t hal_read_scratch_word(uint32_t offset) {
+    return hal_read_reg32((volatile uint32_t*)(SCRATCH_BASE_ADDR + offset));
+}
+
+/**
+ * @brief Write one word of the large GEMM descriptor
+ * @param index Descriptor word index (GEMM_DESC_*)
+ * @param value Word value
+ */
+static inline void hal_write_gemm_desc(int index, uint32_t value) {
+    hal_write_reg32((volatile uint32_t*)(GEMM_DESC_ADDR + (index * 4)), value);
+}
+
+/**
+ * @brief Write one word of the in-place operand descriptor
+ * @param index Descriptor word index (RAM_DESC_*)
+ * @param value Word value
+ */
+static inline void hal_write_ram_desc(int index, uint32_t value) {
+    hal_write_reg32((volatile uint32_t*)(RAM_DESC_ADDR + (index * 4)), value);
+}
+
+/**
+ * @brief Write one word of the CSR SpMV descriptor
+ * @param index Descriptor word index (SPMV_DESC_*)
+ * @param value Word value
+ */
+static inline void hal_write_spmv_desc(int index, uint32_t value) {
+    hal_write_reg32((volatile uint32_t*)(SPMV_DESC_ADDR + (index * 4)), value);
+}
+
+/**
+ * @brief Write one word of the pooling descriptor
+ * @param index Descriptor word index (POOL_DESC_*)
+ * @param value Word value
+ */
+static inline void hal_write_pool_desc(int index, uint32_t value) {
+    hal_write_reg32((volatile uint32_t*)(POOL_DESC_ADDR + (index * 4)), value);
+}
+
+/**
+ * @brief Write one word of the normalization descriptor
+ * @param index Descriptor word index (NORM_DESC_*)
+ * @param value Word value
+ */
+static inline void hal_write_norm_desc(int index, uint32_t value) {
+    hal_write_reg32((volatile uint32_t*)(NORM_DESC_ADDR + (index * 4)), value);
+}
+
+/**
+ * @brief Set the GF(2^8) reduction polynomial
+ * @param poly Low byte of the polynomial (x^8 is implied)
+ */
+static inline void hal_write_gf_poly(uint8_t poly) {
+    hal_write_reg32((volatile uint32_t*)GF_POLY_REG_ADDR, poly);
+}
+
+/**
+ * @brief Read the GF(2^8) reduction polynomial
+ * @return Low byte of the polynomial
+ */
+static inline uint8_t hal_read_gf_poly(void) {
+    return (uint8_t)hal_read_reg32((volatile uint32_t*)GF_POLY_REG_ADDR);
+}
+
+/**
+ * @brief Set the softmax logit shift
+ * @param shift Row differences are shifted right by this before exp()
+ */
+static inline void hal_write_softmax_shift(uint32_t shift) {
+    hal_write_reg32((volatile uint32_t*)SOFTMAX_CFG_REG_ADDR, shift);
+}
+
+/**
+ * @brief Read the conflict counter of one RAM bank
+ * @param bank Bank index (0 to SYSTEM_RAM_BANKS-1)
+ * @return Cycles in which the CPU and accelerator collided on the bank
+ */
+static inline uint32_t hal_read_ram_conflicts(int bank) {
+    return hal_read_reg32((volatile uint32_t*)(RAM_STATS_BASE_ADDR + (bank * 4)));
+}
+
+/**
+ * @brief Clear every RAM bank conflict counter
+ */
+static inline void hal_clear_ram_conflicts(void) {
+    hal_write_reg32((volatile uint32_t*)RAM_STATS_BASE_ADDR, 0);
+}
+
+/**
+ * @brief Write one sequencer instruction
+ * @param index Instruction index (0 to SEQ_IMEM_WORDS-1)
+ * @param insn Encoded instruction
+ */
+static inline void hal_write_seq_insn(int index, uint32_t insn) {
+    hal_write_reg32((volatile uint32_t*)(SEQ_IMEM_ADDR + (index * 4)), insn);
+}
+
+/**
+ * @brief Set the sequencer start PC
+ * @param pc Instruction index to start from
+ */
+static inline void hal_write_seq_entry(uint32_t pc) {
+    hal_write_reg32((volatile uint32_t*)SEQ_ENTRY_REG_ADDR, pc);
+}
+
+/**
+ * @brief Ring the sequencer doorbell, releasing one WAIT
+ */
+static inline void hal_write_seq_signal(void) {
+    hal_write_reg32((volatile uint32_t*)SEQ_SIGNAL_REG_ADDR, 1);
+}
+
+/**
+ * @brief Read the sequencer program counter
+ * @return Current instruction index
+ */
+static inline uint32_t hal_read_seq_pc(void) {
+    return hal_read_reg32((volatile uint32_t*)SEQ_PC_REG_ADDR);
+}
+
+/**
+ * @brief Read the B tile cache generation
+ * @return Current generation
+ */
+static inline uint32_t hal_read_b_gen(void) {
+    return hal_read_reg32((volatile uint32_t*)B_GEN_REG_ADDR) & 0xFF;
+}
+
+/**
+ * @brief Set the B tile cache generation
+ * @param gen New generation; tiles tagged with any other value miss
+ */
+static inline void hal_write_b_gen(uint32_t gen) {
+    hal_write_reg32((volatile uint32_t*)B_GEN_REG_ADDR, gen & 0xFF);
+}
+
+/**
+ * @brief Read the B tile cache hit counter
+ * @return LOAD_B operations served from a resident tile
+ */
+static inline uint32_t hal_read_b_hits(void) {
+    return hal_read_reg32((volatile uint32_t*)B_HITS_REG_ADDR);
+}
+
+/**
+ * @brief Read the B tile cache miss counter
+ * @return LOAD_B operations that copied the tile from the scratchpad
+ */
+static inline uint32_t hal_read_b_misses(void) {
+    return hal_read_reg32((volatile uint32_t*)B_MISSES_REG_ADDR);
+}
+
+/**
+ * @brief Read the length of the last compressed C store
+ * @return Bytes written to the scratchpad by that store
+ */
+static inline uint32_t hal_read_rle_len(void) {
+    return hal_read_reg32((volatile uint32_t*)RLE_LEN_REG_ADDR);
+}
+
+/**
+ * @brief Read the CRC-32 of the last job's result writes
+ * @return Final (already inverted) CRC-32, directly comparable with
+ *         matrix_accel_crc32()
+ */
+static inline uint32_t hal_read_crc_job(void) {
+    return hal_read_reg32((volatile uint32_t*)CRC_JOB_REG_ADDR);
+}
+
+/**
+ * @brief Read the running CRC-32 of all result writes
+ * @return Final (already inverted) CRC-32, directly comparable with
+ *         matrix_accel_crc32()
+ */
+static inline uint32_t hal_read_crc_run(void) {
+    return hal_read_reg32((volatile uint32_t*)CRC_RUN_REG_ADDR);
+}
+
+/**
+ * @brief Restart the running result CRC
+ */
+static inline void hal_clear_crc_run(void) {
+    hal_write_reg32((volatile uint32_t*)CRC_RUN_REG_ADDR, 0);
+}
+
+/**
+ * @brief Write a register of an accelerator unit
+ * @param unit Unit index (0 to MATRIX_ACCEL_NUM_UNITS-1)
+ * @param offset Register offset within the unit window
+ * @param value Value to write
+ */
+static inline void hal_write_unit_reg32(int unit, uint32_t offset, uint32_t value) {
+    hal_write_reg32((volatile uint32_t*)(MATRIX_ACCEL_UNIT_BASE(unit) + offset), value);
+}
+
+/**
+ * @brief Read a register of an accelerator unit
+ * @param unit Unit index (0 to MATRIX_ACCEL_NUM_UNITS-1)
+ * @param offset Register offset within the unit window
+ * @return Register value
+ */
+static inline uint32_t hal_read_unit_reg32(int unit, uint32_t offset) {
+    return hal_read_reg32((volatile uint32_t*)(MATRIX_ACCEL_UNIT_BASE(unit) + offset));
+}
+
+/**
+ * @brief Write a register in every unit selected by the broadcast mask
+ * @param offset Register offset within the unit window
+ * @param value Value to write
+ */
+static inline void hal_write_bcast_reg32(uint32_t offset, uint32_t value) {
+    hal_write_reg32((volatile uint32_t*)(MATRIX_ACCEL_BCAST_BASE + offset), value);
+}
+
+/**
+ * @brief Select the units that receive broadcast writes
+ * @param mask Bit n enables unit n
+ */
+static inline void hal_write_bcast_mask(uint32_t mask) {
+    hal_write_reg32((volatile uint32_t*)BCAST_MASK_REG_ADDR, mask);
+}
+
 /**
  * @brief Write a single element to matrix A
  * @param index Element index (0-15 for 4x4 matrix)
@@ -125,7 +650,7 @@ static inline void hal_write_matrix_a_element(int index, matrix_element_t value)
 
 /**
  * @brief Write a single element to matrix B
- * @param index Element index (0-15 for 4x4 matrix)
+ * @param index Element index (0-15 for 4x4 matrix, column-major)
  * @param value Element value
  */
 static inline void hal_write_matrix_b_element(int index, matrix_element_t value) {
@@ -133,6 +658,16 @@ static inline void hal_write_matrix_b_element(int index, matrix_element_t value)
     hal_write_reg32(addr, (uint32_t)value);
 }
 
+/**
+ * @brief Write a single element of the attention value tile
+ * @param index Element index (0-15 for 4x4 matrix, column-major)
+ * @param value Element value
+ */
+static inline void hal_write_attn_v_element(int index, matrix_element_t value) {
+    volatile uint32_t* addr = (volatile uint32_t*)(ATTN_V_BASE_ADDR + (index * 4));
+    hal_write_reg32(addr, (uint32_t)value);
+}
+
 /**
  * @brief Read a single element from matrix C
  * @param index Element index (0-15 for 4x4 matrix)
@@ -143,4 +678,45 @@ static inline matrix_result_t hal_read_matrix_c_element(int index) {
     return (matrix_result_t)hal_read_reg32(addr);
 }
 
+/**
+ * @brief Write a complex element to matrix A
+ * @param index Element index (row-major)
+ * @param re Real part
+ * @param im Imaginary part
+ */
+static inline void hal_write_cplx_a_element(int index, int8_t re, int8_t im) {
+    volatile uint32_t* addr = (volatile uint32_t*)(CPLX_A_BASE_ADDR + (index * 4));
+    hal_write_reg32(addr, (uint32_t)(uint8_t)re | ((uint32_t)(uint8_t)im << 8));
+}
+
+/**
+ * @brief Write a complex element to matrix B
+ * @param index Element index (column-major)
+ * @param re Real part
+ * @param im Imaginary part
+ */
+static inline void hal_write_cplx_b_element(int index, int8_t re, int8_t im) {
+    volatile uint32_t* addr = (volatile uint32_t*)(CPLX_B_BASE_ADDR + (index * 4));
+    hal_write_reg32(addr, (uint32_t)(uint8_t)re | ((uint32_t)(uint8_t)im << 8));
+}
+
+/**
+ * @brief Read the imaginary part of a matrix C element
+ * @param index Element index (row-major)
+ */
+static inline int32_t hal_read_c_imag_element(int index) {
+    volatile uint32_t* addr = (volatile uint32_t*)(C_IMAG_BASE_ADDR + (index * 4));
+    return (int32_t)hal_read_reg32(addr);
+}
+
+/**
+ * @brief Read a complex matrix C element packed as two int16 halves
+ * @param index Element index (row-major)
+ * @return Bits 15:0 real, bits 31:16 imaginary, each saturated
+ */
+static inline uint32_t hal_read_cplx_c_packed(int index) {
+    volatile uint32_t* addr = (volatile uint32_t*)(CPLX_C_BASE_ADDR + (index * 4));
+    return hal_read_reg32(addr);
+}
+
 #endif // MATRIX_ACCEL_HAL_H 
\ No newline at end of file
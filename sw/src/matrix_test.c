@@ -24,6 +24,29 @@ static void print_matrix_output(const char* name, const matrix_output_t matrix);
 static bool compare_matrices(const matrix_output_t result, const matrix_output_t expected);
 static void run_test_case(const test_case_t* test);
 static void run_performance_test(void);
+static bool run_stream_test(void);
+static bool run_batch_test(void);
+static bool run_sequencer_test(void);
+static bool run_large_gemm_test(void);
+static bool run_chain_test(void);
+static bool run_bcast_test(void);
+static bool run_bcache_test(void);
+static bool run_inplace_test(void);
+static bool run_rle_test(void);
+static bool run_crc_test(void);
+static bool run_winograd_test(void);
+static bool run_cgemm_test(void);
+static bool run_spmv_test(void);
+static bool run_gf_test(void);
+static bool run_semiring_test(void);
+static bool run_binary_test(void);
+static bool run_dist_test(void);
+static bool run_dwconv_test(void);
+static bool run_pool_test(void);
+static bool run_softmax_test(void);
+static bool run_norm_test(void);
+static bool run_attention_test(void);
+static uint32_t read_cycles(void);
 
 // Test cases
 static const test_case_t test_cases[] = {
@@ -156,12 +179,254 @@ int main(void) {
         printf("\n");
     }
     
+    // Row-streaming mode over the same test cases
+    printf("--- Running Row Streaming Test ---\n");
+    if (run_stream_test()) {
+        printf("PASS: Row streaming test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Row streaming test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // All test cases as one strided batch walked by the accelerator
+    printf("--- Running Strided Batch Test ---\n");
+    if (run_batch_test()) {
+        printf("PASS: Strided batch test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Strided batch test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Same batch expressed as a sequencer program loop
+    printf("--- Running Sequencer Test ---\n");
+    if (run_sequencer_test()) {
+        printf("PASS: Sequencer test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Sequencer test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Non-multiple-of-4 GEMM tiled by the accelerator
+    printf("--- Running Large GEMM Test ---\n");
+    if (run_large_gemm_test()) {
+        printf("PASS: Large GEMM test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Large GEMM test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Two-layer pipeline across chained accelerator units
+    printf("--- Running Chain Test ---\n");
+    if (run_chain_test()) {
+        printf("PASS: Chain test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Chain test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Shared weights multicast to every unit
+    printf("--- Running Broadcast Test ---\n");
+    if (run_bcast_test()) {
+        printf("PASS: Broadcast test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Broadcast test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Repeated weight tiles served from the B tile cache
+    printf("--- Running B Cache Test ---\n");
+    if (run_bcache_test()) {
+        printf("PASS: B cache test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: B cache test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Operands read and results written directly in RAM
+    printf("--- Running In-Place Test ---\n");
+    if (run_inplace_test()) {
+        printf("PASS: In-place test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: In-place test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Sparse activations loaded and results stored zero-run-length compressed
+    printf("--- Running RLE Test ---\n");
+    if (run_rle_test()) {
+        printf("PASS: RLE test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: RLE test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Results validated through the hardware signature, without read-back
+    printf("--- Running Result CRC Test ---\n");
+    if (run_crc_test()) {
+        printf("PASS: Result CRC test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Result CRC test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // 3x3 convolution: Winograd F(2x2,3x3) against the direct im2col path
+    printf("--- Running Winograd Test ---\n");
+    if (run_winograd_test()) {
+        printf("PASS: Winograd test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Winograd test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Complex products in a single job
+    printf("--- Running Complex GEMM Test ---\n");
+    if (run_cgemm_test()) {
+        printf("PASS: Complex GEMM test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Complex GEMM test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Sparse matrix-vector product walked from CSR arrays in RAM
+    printf("--- Running SpMV Test ---\n");
+    if (run_spmv_test()) {
+        printf("PASS: SpMV test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: SpMV test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Reed-Solomon style parity over GF(2^8)
+    printf("--- Running GF(2^8) Erasure Coding Test ---\n");
+    if (run_gf_test()) {
+        printf("PASS: GF(2^8) erasure coding test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: GF(2^8) erasure coding test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Min-plus shortest paths, max-plus and boolean products
+    printf("--- Running Semiring Test ---\n");
+    if (run_semiring_test()) {
+        printf("PASS: Semiring test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Semiring test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Binarized layer on the XNOR-popcount datapath
+    printf("--- Running Binary GEMM Test ---\n");
+    if (run_binary_test()) {
+        printf("PASS: Binary GEMM test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Binary GEMM test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // L1/L2 distance matrices and nearest-neighbor search
+    printf("--- Running Pairwise Distance Test ---\n");
+    if (run_dist_test()) {
+        printf("PASS: Pairwise distance test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Pairwise distance test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Per-channel 3x3 filters over a multi-channel image
+    printf("--- Running Depthwise Convolution Test ---\n");
+    if (run_dwconv_test()) {
+        printf("PASS: Depthwise convolution test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Depthwise convolution test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Pooling of scratchpad results before read-back
+    printf("--- Running Pooling Test ---\n");
+    if (run_pool_test()) {
+        printf("PASS: Pooling test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Pooling test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // Row softmax of a result tile through the exp/reciprocal tables
+    printf("--- Running Softmax Test ---\n");
+    if (run_softmax_test()) {
+        printf("PASS: Softmax test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Softmax test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // LayerNorm and RMSNorm of scratchpad rows
+    printf("--- Running Normalization Test ---\n");
+    if (run_norm_test()) {
+        printf("PASS: Normalization test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Normalization test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
+    // QK^T, softmax and *V chained inside the accelerator
+    printf("--- Running Fused Attention Test ---\n");
+    if (run_attention_test()) {
+        printf("PASS: Fused attention test passed!\n");
+        passed++;
+    } else {
+        printf("FAIL: Fused attention test failed!\n");
+        failed++;
+    }
+    printf("\n");
+    
     // Print summary
     printf("=== Test Summary ===\n");
-    printf("Total tests: %d\n", NUM_TEST_CASES);
+    printf("Total tests: %d\n", passed + failed);
     printf("Passed: %d\n", passed);
     printf("Failed: %d\n", failed);
-    printf("Success rate: %.1f%%\n", (float)passed / NUM_TEST_CASES * 100.0f);
+    printf("Success rate: %.1f%%\n", (float)passed / (passed + failed) * 100.0f);
     
     if (failed == 0) {
         printf("\n🎉 All tests passed! Matrix accelerator is working correctly.\n");
@@ -248,4 +513,1353 @@ static void run_performance_test(void) {
     } else {
         printf("Performance test failed: %s\n", matrix_accel_error_string(result));
     }
-} 
\ No newline at end of file
+    
+    // Same product in place, showing how often CPU and accelerator
+    // collided on a RAM bank
+    uint32_t conflicts[SYSTEM_RAM_BANKS];
+    matrix_accel_clear_ram_conflicts();
+    result = matrix_accel_multiply_inplace(perf_a, perf_b, perf_result, 50000);
+    matrix_accel_get_ram_conflicts(conflicts);
+    
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        printf("In-place RAM bank conflicts:");
+        for (int bank = 0; bank < SYSTEM_RAM_BANKS; bank++) {
+            printf(" %lu", (unsigned long)conflicts[bank]);
+        }
+        printf("\n");
+    } else {
+        printf("In-place performance run failed: %s\n", matrix_accel_error_string(result));
+    }
+}
+
+static bool run_stream_test(void) {
+    bool ok = true;
+    
+    for (int i = 0; i < NUM_TEST_CASES && ok; i++) {
+        matrix_output_t actual_result;
+        
+        // B stays resident; each A row written kicks off its C row
+        if (matrix_accel_load_matrix_b(test_cases[i].matrix_b) != MATRIX_ACCEL_SUCCESS ||
+            matrix_accel_set_stream_mode(true) != MATRIX_ACCEL_SUCCESS) {
+            return false;
+        }
+        
+        matrix_accel_result_t result = matrix_accel_stream_frame(test_cases[i].matrix_a,
+                                                                 actual_result,
+                                                                 10000);
+        matrix_accel_set_stream_mode(false);
+        
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: Streaming failed: %s\n", matrix_accel_error_string(result));
+            return false;
+        }
+        
+        ok = compare_matrices(actual_result, test_cases[i].expected_result);
+    }
+    
+    return ok;
+}
+
+static bool run_batch_test(void) {
+    const matrix_accel_batch_desc_t desc = {
+        .batch_count = NUM_TEST_CASES,
+        .a_base = 0x000,
+        .b_base = 0x100,
+        .c_base = 0x200,
+        .a_stride = sizeof(matrix_input_t),
+        .b_stride = sizeof(matrix_input_t),
+        .c_stride = sizeof(matrix_output_t)
+    };
+    
+    for (int i = 0; i < NUM_TEST_CASES; i++) {
+        if (matrix_accel_scratch_write(desc.a_base + i * desc.a_stride,
+                                       test_cases[i].matrix_a, sizeof(matrix_input_t)) != MATRIX_ACCEL_SUCCESS ||
+            matrix_accel_scratch_write(desc.b_base + i * desc.b_stride,
+                                       test_cases[i].matrix_b, sizeof(matrix_input_t)) != MATRIX_ACCEL_SUCCESS) {
+            return false;
+        }
+    }
+    
+    matrix_accel_result_t result = matrix_accel_batch_start(&desc);
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_wait_done(10000 * NUM_TEST_CASES);
+    }
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Batch failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    for (int i = 0; i < NUM_TEST_CASES; i++) {
+        matrix_output_t actual_result;
+        matrix_accel_scratch_read(desc.c_base + i * desc.c_stride, actual_result, sizeof(matrix_output_t));
+        if (!compare_matrices(actual_result, test_cases[i].expected_result)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+static bool run_sequencer_test(void) {
+    const uint32_t program[] = {
+        SEQ_SETA(0, 0x000),
+        SEQ_SETA(1, 0x100),
+        SEQ_SETA(2, 0x200),
+        SEQ_SETC(0, NUM_TEST_CASES),
+        /* 4: */ SEQ_LDA(0, MATRIX_SIZE),
+        SEQ_LDB(1, MATRIX_SIZE),
+        SEQ_GEMM(),
+        SEQ_STC(2, MATRIX_SIZE * 4),
+        SEQ_ADDA(0, sizeof(matrix_input_t)),
+        SEQ_ADDA(1, sizeof(matrix_input_t)),
+        SEQ_ADDA(2, sizeof(matrix_output_t)),
+        SEQ_LOOP(0, 4),
+        SEQ_END()
+    };
+    
+    // Clear the result area so stale batch results cannot pass
+    matrix_output_t zero = {{0}};
+    for (int i = 0; i < NUM_TEST_CASES; i++) {
+        matrix_accel_scratch_write(0x000 + i * sizeof(matrix_input_t), test_cases[i].matrix_a, sizeof(matrix_input_t));
+        matrix_accel_scratch_write(0x100 + i * sizeof(matrix_input_t), test_cases[i].matrix_b, sizeof(matrix_input_t));
+        matrix_accel_scratch_write(0x200 + i * sizeof(matrix_output_t), zero, sizeof(matrix_output_t));
+    }
+    
+    matrix_accel_result_t result = matrix_accel_seq_load(program, sizeof(program) / sizeof(program[0]));
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_seq_start(0);
+    }
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_wait_done(10000 * NUM_TEST_CASES);
+    }
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Sequencer program failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    for (int i = 0; i < NUM_TEST_CASES; i++) {
+        matrix_output_t actual_result;
+        matrix_accel_scratch_read(0x200 + i * sizeof(matrix_output_t), actual_result, sizeof(matrix_output_t));
+        if (!compare_matrices(actual_result, test_cases[i].expected_result)) {
+            return false;
+        }
+    }
+    
+    // (A0 * B0 + A1 * B1) >> 1, held at a WAIT until the CPU rings the doorbell
+    const uint32_t accumulate[] = {
+        SEQ_SETA(0, 0x000),
+        SEQ_SETA(1, 0x100),
+        SEQ_SETA(2, 0x300),
+        SEQ_LDA(0, MATRIX_SIZE),
+        SEQ_LDB(1, MATRIX_SIZE),
+        SEQ_GEMM(),
+        SEQ_ADDA(0, sizeof(matrix_input_t)),
+        SEQ_ADDA(1, sizeof(matrix_input_t)),
+        SEQ_LDA(0, MATRIX_SIZE),
+        SEQ_LDB(1, MATRIX_SIZE),
+        SEQ_GEMMA(),
+        SEQ_ELT(SEQ_ELT_SRA(1)),
+        /* 12: */ SEQ_WAIT(),
+        SEQ_STC(2, MATRIX_SIZE * 4),
+        SEQ_END()
+    };
+    
+    result = matrix_accel_seq_load(accumulate, sizeof(accumulate) / sizeof(accumulate[0]));
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_seq_start(0);
+    }
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Sequencer GEMMA/ELT program failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    // Without a doorbell the program must park at its WAIT
+    if (matrix_accel_wait_done(5000) != MATRIX_ACCEL_ERROR_TIMEOUT || hal_read_seq_pc() != 12) {
+        printf("ERROR: Sequencer did not stop at WAIT (pc %lu)\n", (unsigned long)hal_read_seq_pc());
+        return false;
+    }
+    matrix_accel_seq_signal();
+    result = matrix_accel_wait_done(10000);
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Sequencer did not resume after the doorbell: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    matrix_output_t actual_result;
+    matrix_output_t expected;
+    matrix_accel_scratch_read(0x300, actual_result, sizeof(matrix_output_t));
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        for (int col = 0; col < MATRIX_SIZE; col++) {
+            expected[row][col] = (test_cases[0].expected_result[row][col] +
+                                  test_cases[1].expected_result[row][col]) >> 1;
+        }
+    }
+    
+    return compare_matrices(actual_result, expected);
+}
+
+static bool run_large_gemm_test(void) {
+    // 6x5 * 5x7 exercises edge tiles in every dimension
+    enum { GM = 6, GN = 5, GP = 7, LDA = 8, LDB = 8 };
+    const matrix_accel_gemm_desc_t desc = {
+        .m = GM, .n = GN, .p = GP,
+        .a_base = 0x400, .b_base = 0x480, .c_base = 0x500,
+        .lda = LDA, .ldb = LDB, .ldc = GP * 4
+    };
+    uint8_t a[GM][LDA] = {{0}};
+    uint8_t b[GN][LDB] = {{0}};
+    uint32_t c[GM][GP];
+    
+    for (int i = 0; i < GM; i++) {
+        for (int k = 0; k < GN; k++) {
+            a[i][k] = (uint8_t)(i + k + 1);
+        }
+    }
+    for (int k = 0; k < GN; k++) {
+        for (int j = 0; j < GP; j++) {
+            b[k][j] = (uint8_t)((k * GP + j) % 5);
+        }
+    }
+    
+    matrix_accel_scratch_write(desc.a_base, a, sizeof(a));
+    matrix_accel_scratch_write(desc.b_base, b, sizeof(b));
+    
+    matrix_accel_result_t result = matrix_accel_gemm_start(&desc);
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_wait_done(50000);
+    }
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Large GEMM failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    matrix_accel_scratch_read(desc.c_base, c, sizeof(c));
+    for (int i = 0; i < GM; i++) {
+        for (int j = 0; j < GP; j++) {
+            uint32_t expected = 0;
+            for (int k = 0; k < GN; k++) {
+                expected += a[i][k] * b[k][j];
+            }
+            if (c[i][j] != expected) {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+static bool run_chain_test(void) {
+    enum { LAYERS = 2, SHIFT = 2 };
+    matrix_input_t weights[LAYERS];
+    bool ok = true;
+    
+    memcpy(weights[0], test_cases[0].matrix_b, sizeof(matrix_input_t));
+    memcpy(weights[1], test_cases[NUM_TEST_CASES - 1].matrix_b, sizeof(matrix_input_t));
+    
+    if (matrix_accel_chain_setup(LAYERS, weights, SHIFT) != MATRIX_ACCEL_SUCCESS) {
+        return false;
+    }
+    
+    for (int f = 0; f < NUM_TEST_CASES && ok; f++) {
+        matrix_input_t hidden;
+        matrix_output_t actual_result;
+        
+        // Reference on signed 8-bit elements: layer 0, requantize, layer 1
+        for (int i = 0; i < MATRIX_SIZE; i++) {
+            for (int j = 0; j < MATRIX_SIZE; j++) {
+                int32_t acc = 0;
+                for (int k = 0; k < MATRIX_SIZE; k++) {
+                    acc += (int8_t)test_cases[f].matrix_a[i][k] * (int8_t)weights[0][k][j];
+                }
+                acc >>= SHIFT;
+                hidden[i][j] = (matrix_element_t)(acc > 127 ? 127 : acc < -128 ? -128 : acc);
+            }
+        }
+        
+        matrix_accel_result_t result = matrix_accel_chain_frame(LAYERS, test_cases[f].matrix_a,
+                                                                actual_result, 10000);
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: Chained frame failed: %s\n", matrix_accel_error_string(result));
+            ok = false;
+            break;
+        }
+        
+        for (int i = 0; i < MATRIX_SIZE && ok; i++) {
+            for (int j = 0; j < MATRIX_SIZE; j++) {
+                int32_t expected = 0;
+                for (int k = 0; k < MATRIX_SIZE; k++) {
+                    expected += (int8_t)hidden[i][k] * (int8_t)weights[1][k][j];
+                }
+                if (actual_result[i][j] != (matrix_result_t)expected) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+    }
+    
+    // Restore independent single-unit operation
+    for (int unit = 0; unit < LAYERS; unit++) {
+        matrix_accel_chain_config(unit, false, false, 0);
+    }
+    matrix_accel_set_stream_mode(false);
+    
+    return ok;
+}
+
+static bool run_bcast_test(void) {
+    const test_case_t* test = &test_cases[0];
+    
+    if (matrix_accel_bcast_load_matrix_b(BCAST_MASK_ALL, test->matrix_b) != MATRIX_ACCEL_SUCCESS) {
+        return false;
+    }
+    
+    // A and the start command are multicast as well, so all units run together
+    for (int row = 0; row < MATRIX_SIZE; row++) {
+        for (int col = 0; col < MATRIX_SIZE; col++) {
+            hal_write_bcast_reg32(MATRIX_A_BASE_OFFSET + (row * MATRIX_SIZE + col) * 4,
+                                  test->matrix_a[row][col]);
+        }
+    }
+    hal_write_bcast_reg32(CONTROL_REG_OFFSET, CONTROL_START_BIT);
+    
+    for (int unit = 0; unit < MATRIX_ACCEL_NUM_UNITS; unit++) {
+        matrix_output_t actual_result;
+        for (int row = 0; row < MATRIX_SIZE; row++) {
+            if (matrix_accel_unit_read_row(unit, row, actual_result[row], 10000) != MATRIX_ACCEL_SUCCESS) {
+                printf("ERROR: Unit %d did not finish\n", unit);
+                return false;
+            }
+        }
+        if (!compare_matrices(actual_result, test->expected_result)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+static bool run_bcache_test(void) {
+    // Reruns the large GEMM, whose operands are still in the scratchpad.
+    // Its four B tiles are used by both row blocks of C.
+    const matrix_accel_gemm_desc_t desc = {
+        .m = 6, .n = 5, .p = 7,
+        .a_base = 0x400, .b_base = 0x480, .c_base = 0x500,
+        .lda = 8, .ldb = 8, .ldc = 7 * 4
+    };
+    uint32_t expected[6][7];
+    uint32_t c[6][7];
+    uint32_t hits, misses;
+    
+    matrix_accel_scratch_read(desc.c_base, expected, sizeof(expected));
+    
+    // Cold: first row block misses, second hits
+    matrix_accel_bcache_invalidate();
+    matrix_accel_bcache_clear_stats();
+    if (matrix_accel_gemm_start(&desc) != MATRIX_ACCEL_SUCCESS ||
+        matrix_accel_wait_done(50000) != MATRIX_ACCEL_SUCCESS) {
+        return false;
+    }
+    matrix_accel_bcache_get_stats(&hits, &misses);
+    if (hits != 4 || misses != 4) {
+        printf("ERROR: Cold run hits=%lu misses=%lu\n", (unsigned long)hits, (unsigned long)misses);
+        return false;
+    }
+    
+    // Warm: every tile is resident
+    matrix_accel_bcache_clear_stats();
+    if (matrix_accel_gemm_start(&desc) != MATRIX_ACCEL_SUCCESS ||
+        matrix_accel_wait_done(50000) != MATRIX_ACCEL_SUCCESS) {
+        return false;
+    }
+    matrix_accel_bcache_get_stats(&hits, &misses);
+    if (hits != 8 || misses != 0) {
+        printf("ERROR: Warm run hits=%lu misses=%lu\n", (unsigned long)hits, (unsigned long)misses);
+        return false;
+    }
+    
+    matrix_accel_scratch_read(desc.c_base, c, sizeof(c));
+    return memcmp(c, expected, sizeof(c)) == 0;
+}
+
+static bool run_inplace_test(void) {
+    for (int i = 0; i < NUM_TEST_CASES; i++) {
+        // Test vectors are ROM constants; the accelerator only reaches RAM
+        matrix_input_t a, b;
+        matrix_output_t actual_result;
+        
+        memcpy(a, test_cases[i].matrix_a, sizeof(a));
+        memcpy(b, test_cases[i].matrix_b, sizeof(b));
+        memset(actual_result, 0, sizeof(actual_result));
+        
+        matrix_accel_result_t result = matrix_accel_multiply_inplace(a, b, actual_result, 10000);
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: In-place multiply failed: %s\n", matrix_accel_error_string(result));
+            return false;
+        }
+        
+        if (!compare_matrices(actual_result, test_cases[i].expected_result)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+static bool run_rle_test(void) {
+    enum { A_Z = 0x600, B_OFF = 0x640, C_OFF = 0x680, C_Z = 0x6C0, SHIFT = 2 };
+    const matrix_input_t a = {
+        {0, 0, 3, 0},
+        {0, 0, 0, 0},
+        {0x85, 7, 0, 0},
+        {0, 0, 0, 1}
+    };
+    uint8_t stream[64] = {0};
+    uint8_t packed[MATRIX_SIZE * MATRIX_SIZE];
+    matrix_output_t c;
+    
+    uint32_t len = matrix_accel_rle_encode(&a[0][0], sizeof(a), stream, sizeof(stream));
+    if (len == 0) {
+        return false;
+    }
+    printf("A compressed to %lu of %u bytes\n", (unsigned long)len, (unsigned)sizeof(a));
+    
+    matrix_accel_scratch_write(A_Z, stream, (len + 3) & ~3u);
+    matrix_accel_scratch_write(B_OFF, test_cases[0].matrix_b, sizeof(matrix_input_t));
+    
+    const uint32_t program[] = {
+        SEQ_SETA(0, A_Z),
+        SEQ_SETA(1, B_OFF),
+        SEQ_SETA(2, C_OFF),
+        SEQ_SETA(3, C_Z),
+        SEQ_LDAZ(0),
+        SEQ_LDB(1, MATRIX_SIZE),
+        SEQ_GEMM(),
+        SEQ_STC(2, MATRIX_SIZE * 4),
+        SEQ_STCZ(3, SHIFT),
+        SEQ_END()
+    };
+    
+    matrix_accel_result_t result = matrix_accel_seq_load(program, sizeof(program) / sizeof(program[0]));
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_seq_start(0);
+    }
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_wait_done(10000);
+    }
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: RLE program failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    // Uncompressed result against a reference product
+    matrix_accel_scratch_read(C_OFF, c, sizeof(c));
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            int32_t expected = 0;
+            for (int k = 0; k < MATRIX_SIZE; k++) {
+                expected += (int8_t)a[i][k] * (int8_t)test_cases[0].matrix_b[k][j];
+            }
+            if ((int32_t)c[i][j] != expected) {
+                return false;
+            }
+        }
+    }
+    
+    // Compressed result must expand to the requantized C
+    len = matrix_accel_get_rle_len();
+    if (len == 0 || len > sizeof(stream)) {
+        return false;
+    }
+    matrix_accel_scratch_read(C_Z, stream, (len + 3) & ~3u);
+    if (matrix_accel_rle_decode(stream, len, packed, sizeof(packed)) != MATRIX_ACCEL_SUCCESS) {
+        return false;
+    }
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            int32_t q = (int32_t)c[i][j] >> SHIFT;
+            if (q > 127) q = 127;
+            if (q < -128) q = -128;
+            if ((int8_t)packed[i * MATRIX_SIZE + j] != q) {
+                return false;
+            }
+        }
+    }
+    printf("C compressed to %lu bytes\n", (unsigned long)len);
+    
+    return true;
+}
+
+static bool run_crc_test(void) {
+    uint32_t expected_run = 0;
+    
+    matrix_accel_clear_result_crc();
+    
+    for (int i = 0; i < NUM_TEST_CASES; i++) {
+        const matrix_result_t* expected = &test_cases[i].expected_result[0][0];
+        uint32_t job_crc, run_crc;
+        
+        matrix_accel_result_t result = matrix_accel_load_matrices(test_cases[i].matrix_a, test_cases[i].matrix_b);
+        if (result == MATRIX_ACCEL_SUCCESS) {
+            result = matrix_accel_start();
+        }
+        if (result == MATRIX_ACCEL_SUCCESS) {
+            result = matrix_accel_wait_done(10000);
+        }
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: Multiply failed: %s\n", matrix_accel_error_string(result));
+            return false;
+        }
+        
+        // Two register reads instead of reading back all of matrix C
+        matrix_accel_get_result_crc(&job_crc, &run_crc);
+        expected_run = matrix_accel_crc32(expected_run, expected, MATRIX_SIZE * MATRIX_SIZE);
+        if (job_crc != matrix_accel_crc32(0, expected, MATRIX_SIZE * MATRIX_SIZE) ||
+            run_crc != expected_run) {
+            printf("ERROR: Test case %d CRC 0x%08lx, running 0x%08lx\n", i,
+                   (unsigned long)job_crc, (unsigned long)run_crc);
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+static uint32_t read_cycles(void) {
+#ifdef __riscv
+    uint32_t cycles;
+    __asm__ volatile ("rdcycle %0" : "=r"(cycles));
+    return cycles;
+#else
+    return 0;
+#endif
+}
+
+static bool run_winograd_test(void) {
+    enum { H = 10, W = 10, OH = H - 2, OW = W - 2 };
+    const int8_t kernel[3][3] = {
+        {1, 0, -1},
+        {2, 1, -2},
+        {1, 0, -1}
+    };
+    int8_t input[H * W];
+    int32_t direct[OH * OW];
+    int32_t winograd[OH * OW];
+    
+    for (int i = 0; i < H * W; i++) {
+        input[i] = (int8_t)((i * 7) % 63 - WINOGRAD_INPUT_MAX);
+    }
+    
+    uint32_t t0 = read_cycles();
+    matrix_accel_result_t result = matrix_accel_conv3x3_direct(input, H, W, kernel, direct, 50000);
+    uint32_t t1 = read_cycles();
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_conv3x3_winograd(input, H, W, kernel, winograd, 50000);
+    }
+    uint32_t t2 = read_cycles();
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Convolution failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    for (int y = 0; y < OH; y++) {
+        for (int x = 0; x < OW; x++) {
+            int32_t expected = 0;
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    expected += kernel[i][j] * input[(y + i) * W + x + j];
+                }
+            }
+            if (direct[y * OW + x] != expected || winograd[y * OW + x] != expected) {
+                printf("ERROR: Output (%d,%d) direct %ld Winograd %ld expected %ld\n", y, x,
+                       (long)direct[y * OW + x], (long)winograd[y * OW + x], (long)expected);
+                return false;
+            }
+        }
+    }
+    
+    // Useful multiplies: 9 per output direct, 16 per 2x2 tile with Winograd
+    printf("Direct:   %lu cycles, %d multiplies\n", (unsigned long)(t1 - t0), OH * OW * 9);
+    printf("Winograd: %lu cycles, %d multiplies\n", (unsigned long)(t2 - t1), (OH / 2) * (OW / 2) * 16);
+    
+    return true;
+}
+
+// Runs one plain MAC job and checks C against the known result
+static bool check_plain_job(void) {
+    matrix_output_t result;
+    
+    matrix_accel_result_t status = matrix_accel_multiply(test_cases[1].matrix_a,
+                                                         test_cases[1].matrix_b,
+                                                         result, 1000);
+    if (status != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Plain job failed: %s\n", matrix_accel_error_string(status));
+        return false;
+    }
+    
+    return compare_matrices(result, test_cases[1].expected_result);
+}
+
+static bool run_cgemm_test(void) {
+    matrix_cinput_t a, b;
+    matrix_coutput_t c;
+    
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            a[i][j].re = (int8_t)(i * 9 + j * 5 - 20);
+            a[i][j].im = (int8_t)(j * 7 - i * 3);
+            b[i][j].re = (int8_t)((i + 2 * j) % 5 - 2);
+            b[i][j].im = (int8_t)(i == j ? 127 : -128 + i + j);
+        }
+    }
+    
+    matrix_accel_result_t result = matrix_accel_cgemm(a, b, c, 10000);
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Complex GEMM failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            int32_t re = 0, im = 0;
+            for (int k = 0; k < MATRIX_SIZE; k++) {
+                re += a[i][k].re * b[k][j].re - a[i][k].im * b[k][j].im;
+                im += a[i][k].re * b[k][j].im + a[i][k].im * b[k][j].re;
+            }
+            if (c[i][j].re != re || c[i][j].im != im) {
+                return false;
+            }
+        }
+    }
+    
+    // A real job afterwards must not see the imaginary operands
+    return check_plain_job();
+}
+
+static bool run_spmv_test(void) {
+    enum { ROWS = 24, COLS = 40, MAX_NNZ = 2 * ROWS };
+    uint32_t row_ptr[ROWS + 1];
+    uint32_t col_idx[MAX_NNZ];
+    int8_t values[MAX_NNZ];
+    int8_t x[COLS];
+    int32_t y[ROWS];
+    uint32_t nnz = 0;
+    
+    // Up to two nonzeros per row, every third row empty
+    for (int r = 0; r < ROWS; r++) {
+        row_ptr[r] = nnz;
+        if (r % 3 == 2) {
+            continue;
+        }
+        col_idx[nnz] = (r * 7 + 3) % COLS;
+        values[nnz++] = (int8_t)(r - 12);
+        if (r % 2 == 0) {
+            col_idx[nnz] = (r * 13 + 1) % COLS;
+            values[nnz++] = (int8_t)(-100 + r);
+        }
+    }
+    row_ptr[ROWS] = nnz;
+    for (int c = 0; c < COLS; c++) {
+        x[c] = (int8_t)((c * 11) % 256 - 128);
+    }
+    memset(y, 0x5A, sizeof(y));
+    
+    const matrix_accel_csr_t matrix = {
+        .rows = ROWS, .cols = COLS,
+        .row_ptr = row_ptr, .col_idx = col_idx, .values = values
+    };
+    matrix_accel_result_t result = matrix_accel_spmv_csr(&matrix, x, y, 50000);
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: SpMV failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    for (int r = 0; r < ROWS; r++) {
+        int32_t expected = 0;
+        for (uint32_t e = row_ptr[r]; e < row_ptr[r + 1]; e++) {
+            expected += values[e] * x[col_idx[e]];
+        }
+        if (y[r] != expected) {
+            printf("ERROR: Row %d got %ld expected %ld\n", r, (long)y[r], (long)expected);
+            return false;
+        }
+    }
+    printf("%lu nonzeros in a %dx%d matrix\n", (unsigned long)nnz, ROWS, COLS);
+    
+    return true;
+}
+
+static bool run_gf_test(void) {
+    enum { DATA = 5, PARITY = 3, LEN = 200 };
+    static const uint8_t polys[2] = { GF_POLY_DEFAULT, 0x1B };
+    static uint8_t blocks[DATA][LEN];
+    static uint8_t check[PARITY][LEN];
+    uint8_t coding[PARITY][DATA];
+    const uint8_t* data[DATA];
+    uint8_t* parity[PARITY];
+    
+    for (int d = 0; d < DATA; d++) {
+        for (int i = 0; i < LEN; i++) {
+            blocks[d][i] = (uint8_t)(i * 37 + d * 101 + (i >> 3));
+        }
+        data[d] = blocks[d];
+    }
+    for (int r = 0; r < PARITY; r++) {
+        parity[r] = check[r];
+    }
+    
+    for (int p = 0; p < 2; p++) {
+        uint8_t poly = polys[p];
+        
+        // Vandermonde rows: coding[r][d] = (d+1)^r
+        for (int d = 0; d < DATA; d++) {
+            uint8_t power = 1;
+            for (int r = 0; r < PARITY; r++) {
+                coding[r][d] = power;
+                power = matrix_accel_gf_mul(power, (uint8_t)(d + 1), poly);
+            }
+        }
+        
+        memset(check, 0, sizeof(check));
+        matrix_accel_result_t result = matrix_accel_gf_encode(&coding[0][0], PARITY, data, DATA,
+                                                              parity, LEN, poly, 50000);
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: GF encode failed: %s\n", matrix_accel_error_string(result));
+            return false;
+        }
+        
+        for (int r = 0; r < PARITY; r++) {
+            for (int i = 0; i < LEN; i++) {
+                uint8_t expected = 0;
+                for (int d = 0; d < DATA; d++) {
+                    expected ^= matrix_accel_gf_mul(coding[r][d], blocks[d][i], poly);
+                }
+                if (check[r][i] != expected) {
+                    printf("ERROR: Poly 0x%02x parity %d byte %d got 0x%02x expected 0x%02x\n",
+                           poly, r, i, check[r][i], expected);
+                    return false;
+                }
+            }
+        }
+    }
+    
+    // Integer jobs are unaffected afterwards
+    return check_plain_job();
+}
+
+static bool run_semiring_test(void) {
+    enum { V = 6, LD = 8, INF = 127 };
+    static const uint8_t edges[][3] = {
+        {0, 1, 7}, {0, 2, 9}, {0, 5, 14}, {1, 2, 10}, {1, 3, 15},
+        {2, 3, 11}, {2, 5, 2}, {3, 4, 6}, {4, 5, 9}
+    };
+    const matrix_accel_gemm_desc_t desc = {
+        .m = V, .n = V, .p = V,
+        .a_base = 0x000, .b_base = 0x040, .c_base = 0x080,
+        .lda = LD, .ldb = LD, .ldc = V * sizeof(uint32_t)
+    };
+    uint8_t dist[V][LD];
+    int32_t ref[V][V];
+    int32_t c[V][V];
+    matrix_accel_result_t result;
+    
+    // All-pairs shortest paths by repeated min-plus squaring; the 6x6
+    // matrix exercises the edge tile padding. Node 5 only reaches itself.
+    memset(dist, INF, sizeof(dist));
+    for (int i = 0; i < V; i++) {
+        dist[i][i] = 0;
+    }
+    for (unsigned e = 0; e < sizeof(edges) / sizeof(edges[0]); e++) {
+        dist[edges[e][0]][edges[e][1]] = edges[e][2];
+    }
+    for (int i = 0; i < V; i++) {
+        for (int j = 0; j < V; j++) {
+            ref[i][j] = dist[i][j];
+        }
+    }
+    for (int k = 0; k < V; k++) {
+        for (int i = 0; i < V; i++) {
+            for (int j = 0; j < V; j++) {
+                if (ref[i][k] + ref[k][j] < ref[i][j]) {
+                    ref[i][j] = ref[i][k] + ref[k][j];
+                }
+            }
+        }
+    }
+    
+    matrix_accel_set_pe_op(PE_OP_MINPLUS);
+    for (int step = 0; step < 3; step++) {
+        matrix_accel_scratch_write(desc.a_base, dist, sizeof(dist));
+        matrix_accel_scratch_write(desc.b_base, dist, sizeof(dist));
+        matrix_accel_bcache_invalidate();
+        
+        result = matrix_accel_gemm_start(&desc);
+        if (result == MATRIX_ACCEL_SUCCESS) {
+            result = matrix_accel_wait_done(50000);
+        }
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: Min-plus GEMM failed: %s\n", matrix_accel_error_string(result));
+            matrix_accel_set_pe_op(PE_OP_MAC);
+            return false;
+        }
+        matrix_accel_scratch_read(desc.c_base, c, sizeof(c));
+        for (int i = 0; i < V; i++) {
+            for (int j = 0; j < V; j++) {
+                dist[i][j] = (uint8_t)(c[i][j] > INF ? INF : c[i][j]);
+            }
+        }
+    }
+    for (int i = 0; i < V; i++) {
+        for (int j = 0; j < V; j++) {
+            int32_t expected = ref[i][j] > INF ? INF : ref[i][j];
+            if (dist[i][j] != expected) {
+                printf("ERROR: Distance %d->%d got %d expected %ld\n", i, j, dist[i][j], (long)expected);
+                matrix_accel_set_pe_op(PE_OP_MAC);
+                return false;
+            }
+        }
+    }
+    
+    // Max-plus and boolean products on single 4x4 jobs
+    matrix_input_t a, b;
+    matrix_output_t out;
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            a[i][j] = (matrix_element_t)(i * 37 - j * 53 - 20);
+            b[i][j] = (matrix_element_t)(j * 29 + i * 11 - 90);
+        }
+    }
+    for (int op = PE_OP_MAXPLUS; op <= PE_OP_BOOL; op++) {
+        matrix_accel_set_pe_op(op);
+        result = matrix_accel_multiply(a, b, out, 10000);
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            matrix_accel_set_pe_op(PE_OP_MAC);
+            return false;
+        }
+        for (int i = 0; i < MATRIX_SIZE; i++) {
+            for (int j = 0; j < MATRIX_SIZE; j++) {
+                int32_t expected = (op == PE_OP_MAXPLUS) ? INT32_MIN : 0;
+                for (int k = 0; k < MATRIX_SIZE; k++) {
+                    if (op == PE_OP_MAXPLUS) {
+                        int32_t sum = (int8_t)a[i][k] + (int8_t)b[k][j];
+                        expected = sum > expected ? sum : expected;
+                    } else {
+                        expected |= a[i][k] & b[k][j];
+                    }
+                }
+                if ((int32_t)out[i][j] != expected) {
+                    printf("ERROR: Op %d C[%d][%d] got %ld expected %ld\n",
+                           op, i, j, (long)(int32_t)out[i][j], (long)expected);
+                    matrix_accel_set_pe_op(PE_OP_MAC);
+                    return false;
+                }
+            }
+        }
+    }
+    
+    matrix_accel_set_pe_op(PE_OP_MAC);
+    return check_plain_job();
+}
+
+static bool run_binary_test(void) {
+    enum { BM = 6, BP = 5, KW = 3 };
+    uint32_t a[BM][KW];
+    uint32_t w[BP][KW];
+    int32_t c[BM][BP];
+    uint32_t seed = 0x12345678;
+    
+    for (int i = 0; i < BM; i++) {
+        for (int k = 0; k < KW; k++) {
+            seed = seed * 1664525 + 1013904223;
+            a[i][k] = seed;
+        }
+    }
+    for (int j = 0; j < BP; j++) {
+        for (int k = 0; k < KW; k++) {
+            seed = seed * 1664525 + 1013904223;
+            w[j][k] = seed;
+        }
+    }
+    // All-equal and all-different rows hit both ends of the range
+    w[0][0] = w[0][1] = w[0][2] = 0;
+    a[0][0] = a[0][1] = a[0][2] = 0;
+    a[1][0] = a[1][1] = a[1][2] = 0xFFFFFFFF;
+    
+    matrix_accel_result_t result = matrix_accel_binary_gemm(&a[0][0], &w[0][0], BM, BP, KW,
+                                                            &c[0][0], 50000);
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Binary GEMM failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    
+    for (int i = 0; i < BM; i++) {
+        for (int j = 0; j < BP; j++) {
+            int32_t expected = 0;
+            for (int k = 0; k < KW; k++) {
+                uint32_t same = ~(a[i][k] ^ w[j][k]);
+                for (int bit = 0; bit < 32; bit++) {
+                    expected += (same >> bit) & 1 ? 1 : -1;
+                }
+            }
+            if (c[i][j] != expected) {
+                printf("ERROR: C[%d][%d] got %ld expected %ld\n", i, j, (long)c[i][j], (long)expected);
+                return false;
+            }
+        }
+    }
+    
+    return c[0][0] == 32 * KW && c[1][0] == -32 * KW;
+}
+
+static bool run_dist_test(void) {
+    enum { NQ = 10, NR = 21, DIM = 13 };
+    static int8_t queries[NQ][DIM];
+    static int8_t refs[NR][DIM];
+    static int32_t dist[NQ][NR];
+    int32_t min_dist[NQ];
+    int argmin[NQ];
+    matrix_accel_result_t result;
+    
+    for (int r = 0; r < NR; r++) {
+        for (int k = 0; k < DIM; k++) {
+            refs[r][k] = (int8_t)((r * 41 + k * 23) % 256 - 128);
+        }
+    }
+    // Queries are perturbed references, so each has a clear nearest one
+    for (int q = 0; q < NQ; q++) {
+        for (int k = 0; k < DIM; k++) {
+            int v = refs[(q * 5) % NR][k] + ((q + k) % 7) - 3;
+            queries[q][k] = (int8_t)(v > 127 ? 127 : v < -128 ? -128 : v);
+        }
+    }
+    
+    // Full L1 matrix
+    result = matrix_accel_pairwise_dist(&queries[0][0], NQ, &refs[0][0], NR, DIM,
+                                        PE_OP_L1, &dist[0][0], NULL, NULL, 50000);
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: L1 distances failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    for (int q = 0; q < NQ; q++) {
+        for (int r = 0; r < NR; r++) {
+            int32_t expected = 0;
+            for (int k = 0; k < DIM; k++) {
+                int32_t d = queries[q][k] - refs[r][k];
+                expected += d < 0 ? -d : d;
+            }
+            if (dist[q][r] != expected) {
+                printf("ERROR: L1 %d,%d got %ld expected %ld\n", q, r, (long)dist[q][r], (long)expected);
+                return false;
+            }
+        }
+    }
+    
+    // Nearest neighbors under L2 without the distance matrix
+    result = matrix_accel_pairwise_dist(&queries[0][0], NQ, &refs[0][0], NR, DIM,
+                                        PE_OP_L2, NULL, min_dist, argmin, 50000);
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: L2 search failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    for (int q = 0; q < NQ; q++) {
+        int32_t best = INT32_MAX;
+        int best_r = -1;
+        for (int r = 0; r < NR; r++) {
+            int32_t sum = 0;
+            for (int k = 0; k < DIM; k++) {
+                int32_t d = queries[q][k] - refs[r][k];
+                sum += d * d;
+            }
+            if (sum < best) {
+                best = sum;
+                best_r = r;
+            }
+        }
+        if (min_dist[q] != best || argmin[q] != best_r) {
+            printf("ERROR: Query %d nearest %d (%ld) expected %d (%ld)\n",
+                   q, argmin[q], (long)min_dist[q], best_r, (long)best);
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+static bool run_dwconv_test(void) {
+    enum { H = 7, W = 9, CH = 20 };
+    static int8_t image[H][W][CH];
+    static int8_t weights[CH][3][3];
+    static int32_t out[(H - 2) * (W - 2) * CH];
+    
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            for (int c = 0; c < CH; c++) {
+                image[y][x][c] = (int8_t)((y * 31 + x * 17 + c * 7) % 256 - 128);
+            }
+        }
+    }
+    for (int c = 0; c < CH; c++) {
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                weights[c][i][j] = (int8_t)((c * 5 + i * 3 - j * 11) % 64 - 20);
+            }
+        }
+    }
+    
+    // 20 channels take a full and a partial group
+    for (int stride = 1; stride <= 2; stride++) {
+        int out_h = (H - 3) / stride + 1;
+        int out_w = (W - 3) / stride + 1;
+        
+        matrix_accel_result_t result = matrix_accel_dwconv2d(&image[0][0][0], H, W, CH,
+                                                             &weights[0][0][0], stride, out, 100000);
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: Depthwise conv failed: %s\n", matrix_accel_error_string(result));
+            return false;
+        }
+        
+        for (int y = 0; y < out_h; y++) {
+            for (int x = 0; x < out_w; x++) {
+                for (int c = 0; c < CH; c++) {
+                    int32_t expected = 0;
+                    for (int i = 0; i < 3; i++) {
+                        for (int j = 0; j < 3; j++) {
+                            expected += weights[c][i][j] * image[y * stride + i][x * stride + j][c];
+                        }
+                    }
+                    int32_t got = out[(y * out_w + x) * CH + c];
+                    if (got != expected) {
+                        printf("ERROR: Stride %d (%d,%d) channel %d got %ld expected %ld\n",
+                               stride, y, x, c, (long)got, (long)expected);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    
+    return true;
+}
+
+static bool run_pool_test(void) {
+    enum { GM = 6, GN = 4, GP = 8, PH = 5, PW = 6, PC = 3 };
+    const matrix_accel_gemm_desc_t gemm = {
+        .m = GM, .n = GN, .p = GP,
+        .a_base = 0x000, .b_base = 0x020, .c_base = 0x100,
+        .lda = GN, .ldb = GP, .ldc = GP * sizeof(int32_t)
+    };
+    int8_t a[GM][GN];
+    int8_t b[GN][GP];
+    int32_t c[GM][GP];
+    int32_t pooled[(GM / 2) * (GP / 2)];
+    matrix_accel_result_t result;
+    
+    for (int i = 0; i < GM; i++) {
+        for (int k = 0; k < GN; k++) {
+            a[i][k] = (int8_t)(i * 19 - k * 27 + 5);
+        }
+    }
+    for (int k = 0; k < GN; k++) {
+        for (int j = 0; j < GP; j++) {
+            b[k][j] = (int8_t)(j * 13 - k * 7 - 30);
+        }
+    }
+    for (int i = 0; i < GM; i++) {
+        for (int j = 0; j < GP; j++) {
+            c[i][j] = 0;
+            for (int k = 0; k < GN; k++) {
+                c[i][j] += a[i][k] * b[k][j];
+            }
+        }
+    }
+    
+    // 2x2/2 max pooling of a GEMM result in place, without reading C back
+    matrix_accel_scratch_write(gemm.a_base, a, sizeof(a));
+    matrix_accel_scratch_write(gemm.b_base, b, sizeof(b));
+    matrix_accel_bcache_invalidate();
+    result = matrix_accel_gemm_start(&gemm);
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_wait_done(50000);
+    }
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        const matrix_accel_pool_desc_t pool = {
+            .src = gemm.c_base, .dst = gemm.c_base,
+            .height = GM, .width = GP, .channels = 1,
+            .window = 2, .stride = 2, .average = false
+        };
+        result = matrix_accel_pool_start(&pool);
+    }
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_wait_done(10000);
+    }
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: GEMM + max pool failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    matrix_accel_scratch_read(gemm.c_base, pooled, sizeof(pooled));
+    for (int y = 0; y < GM / 2; y++) {
+        for (int x = 0; x < GP / 2; x++) {
+            int32_t expected = c[2 * y][2 * x];
+            for (int i = 0; i < 2; i++) {
+                for (int j = 0; j < 2; j++) {
+                    if (c[2 * y + i][2 * x + j] > expected) {
+                        expected = c[2 * y + i][2 * x + j];
+                    }
+                }
+            }
+            if (pooled[y * (GP / 2) + x] != expected) {
+                printf("ERROR: Max pool (%d,%d) got %ld expected %ld\n",
+                       y, x, (long)pooled[y * (GP / 2) + x], (long)expected);
+                return false;
+            }
+        }
+    }
+    
+    // 3x3/1 average pooling of a multi-channel map, mixed signs
+    int32_t map[PH][PW][PC];
+    int32_t avg[PH - 2][PW - 2][PC];
+    for (int y = 0; y < PH; y++) {
+        for (int x = 0; x < PW; x++) {
+            for (int ch = 0; ch < PC; ch++) {
+                map[y][x][ch] = (y * 1000 - x * 777 + ch * 50) * (ch == 1 ? -1 : 1) - 1234;
+            }
+        }
+    }
+    matrix_accel_scratch_write(0x400, map, sizeof(map));
+    const matrix_accel_pool_desc_t pool = {
+        .src = 0x400, .dst = 0x800,
+        .height = PH, .width = PW, .channels = PC,
+        .window = 3, .stride = 1, .average = true
+    };
+    result = matrix_accel_pool_start(&pool);
+    if (result == MATRIX_ACCEL_SUCCESS) {
+        result = matrix_accel_wait_done(10000);
+    }
+    if (result != MATRIX_ACCEL_SUCCESS) {
+        printf("ERROR: Average pool failed: %s\n", matrix_accel_error_string(result));
+        return false;
+    }
+    matrix_accel_scratch_read(0x800, avg, sizeof(avg));
+    for (int y = 0; y < PH - 2; y++) {
+        for (int x = 0; x < PW - 2; x++) {
+            for (int ch = 0; ch < PC; ch++) {
+                int32_t sum = 0;
+                for (int i = 0; i < 3; i++) {
+                    for (int j = 0; j < 3; j++) {
+                        sum += map[y + i][x + j][ch];
+                    }
+                }
+                if (avg[y][x][ch] != sum / 9) {
+                    printf("ERROR: Avg pool (%d,%d,%d) got %ld expected %ld\n",
+                           y, x, ch, (long)avg[y][x][ch], (long)(sum / 9));
+                    return false;
+                }
+            }
+        }
+    }
+    
+    return true;
+}
+
+static bool run_softmax_test(void) {
+    // Identity times B puts these logits in C
+    static const int8_t logits[MATRIX_SIZE][MATRIX_SIZE] = {
+        {10, 10, 10, 10},
+        {20, 12, -100, -100},
+        {-5, -5, -13, 100},
+        {0, -4, -8, -16}
+    };
+    // Q0.7 results for shift 0 and 2, one step of exp() being 1/8
+    static const uint8_t expected[2][MATRIX_SIZE][MATRIX_SIZE] = {
+        {{32, 32, 32, 32}, {93, 34, 0, 0}, {0, 0, 0, 127}, {61, 37, 22, 8}},
+        {{32, 32, 32, 32}, {70, 55, 2, 2}, {4, 4, 3, 116}, {39, 35, 30, 24}}
+    };
+    matrix_input_t identity = {{0}};
+    matrix_input_t b;
+    matrix_output_t c;
+    uint8_t probs[MATRIX_SIZE][MATRIX_SIZE];
+    
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        identity[i][i] = 1;
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            b[i][j] = (matrix_element_t)logits[i][j];
+        }
+    }
+    
+    for (int t = 0; t < 2; t++) {
+        uint32_t shift = t * 2;
+        matrix_accel_result_t result = matrix_accel_multiply(identity, b, c, 1000);
+        if (result == MATRIX_ACCEL_SUCCESS) {
+            result = matrix_accel_softmax(shift, probs, 1000);
+        }
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: Softmax (shift %lu) failed: %s\n",
+                   (unsigned long)shift, matrix_accel_error_string(result));
+            return false;
+        }
+        
+        for (int i = 0; i < MATRIX_SIZE; i++) {
+            for (int j = 0; j < MATRIX_SIZE; j++) {
+                if (probs[i][j] != expected[t][i][j]) {
+                    printf("ERROR: Softmax shift %lu [%d][%d] got %u expected %u\n",
+                           (unsigned long)shift, i, j, probs[i][j], expected[t][i][j]);
+                    return false;
+                }
+            }
+        }
+    }
+    
+    return true;
+}
+
+static uint32_t isqrt64(uint64_t v) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+static bool run_norm_test(void) {
+    enum { ROWS = 3, LEN = 24 };
+    static int32_t x[ROWS][LEN];
+    static int32_t y[ROWS][LEN];
+    static uint32_t params[LEN];
+    matrix_accel_norm_desc_t desc = {
+        .src = 0x000, .dst = 0x200, .params = 0x400,
+        .rows = ROWS, .len = LEN, .eps = 1, .rms = false
+    };
+    
+    // Rows with different offsets and spreads; gamma 32.0 and beta j - 12
+    for (int i = 0; i < ROWS; i++) {
+        for (int j = 0; j < LEN; j++) {
+            x[i][j] = ((j * 37 + i * 11) % 53 - 26) * (i * 150 + 40) + (i - 1) * 20000;
+        }
+    }
+    for (int j = 0; j < LEN; j++) {
+        params[j] = NORM_PARAM(32 * NORM_GAMMA_ONE, j - 12);
+    }
+    matrix_accel_scratch_write(desc.src, x, sizeof(x));
+    matrix_accel_scratch_write(desc.params, params, sizeof(params));
+    
+    for (int mode = 0; mode < 2; mode++) {
+        desc.rms = (mode == 1);
+        matrix_accel_result_t result = matrix_accel_layernorm(&desc, 10000);
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: %s failed: %s\n", desc.rms ? "RMSNorm" : "LayerNorm",
+                   matrix_accel_error_string(result));
+            return false;
+        }
+        matrix_accel_scratch_read(desc.dst, y, sizeof(y));
+        
+        for (int i = 0; i < ROWS; i++) {
+            int32_t sum = 0;
+            for (int j = 0; j < LEN; j++) {
+                sum += x[i][j];
+            }
+            int32_t mean = desc.rms ? 0 : sum / LEN;
+            uint32_t var = desc.eps;
+            for (int j = 0; j < LEN; j++) {
+                int32_t dev = x[i][j] - mean;
+                var += (uint32_t)(dev * dev) / LEN;
+            }
+            // Standard deviation in Q8.8 so 32 * z = dev * 8192 / std_q8
+            uint32_t std_q8 = isqrt64((uint64_t)var << 16);
+            
+            for (int j = 0; j < LEN; j++) {
+                int32_t expected = (x[i][j] - mean) * (32 * NORM_GAMMA_ONE) / (int32_t)std_q8;
+                int32_t err = y[i][j] - (j - 12) - expected;
+                int32_t tol = (expected < 0 ? -expected : expected) / 20 + 2;
+                if (err < -tol || err > tol) {
+                    printf("ERROR: %s [%d][%d] got %ld expected about %ld\n",
+                           desc.rms ? "RMSNorm" : "LayerNorm", i, j,
+                           (long)y[i][j], (long)(expected + j - 12));
+                    return false;
+                }
+            }
+        }
+    }
+    
+    return true;
+}
+
+static bool run_attention_test(void) {
+    static const int8_t q[MATRIX_SIZE][MATRIX_SIZE] = {
+        {3, -1, 2, 0}, {-4, 5, 1, 2}, {0, 0, 0, 0}, {7, 2, -3, -6}
+    };
+    static const int8_t k[MATRIX_SIZE][MATRIX_SIZE] = {
+        {1, 2, -1, 3}, {-2, 4, 0, 1}, {5, -3, 2, -2}, {0, 1, 6, -4}
+    };
+    static const int8_t v[MATRIX_SIZE][MATRIX_SIZE] = {
+        {10, -20, 30, 5}, {-7, 14, 0, 9}, {25, 3, -12, -8}, {-1, 60, 4, 2}
+    };
+    // Q0.7 probabilities of the host scores Q * K^T through the softmax
+    // LUTs (bit-exact, as in run_softmax_test), for shift 0 and 2
+    static const uint8_t probs[2][MATRIX_SIZE][MATRIX_SIZE] = {
+        {{5, 2, 97, 24}, {11, 114, 0, 4}, {32, 32, 32, 32}, {1, 0, 122, 4}},
+        {{26, 18, 48, 37}, {35, 58, 8, 27}, {32, 32, 32, 32}, {20, 16, 62, 29}}
+    };
+    matrix_input_t qi, ki, vi;
+    matrix_output_t fused;
+    
+    for (int i = 0; i < MATRIX_SIZE; i++) {
+        for (int j = 0; j < MATRIX_SIZE; j++) {
+            qi[i][j] = (matrix_element_t)q[i][j];
+            ki[i][j] = (matrix_element_t)k[i][j];
+            vi[i][j] = (matrix_element_t)v[i][j];
+        }
+    }
+    
+    // The fused head must equal P * V computed on the host
+    for (int t = 0; t < 2; t++) {
+        uint32_t shift = t * 2;
+        matrix_accel_result_t result = matrix_accel_attention(qi, ki, vi, shift, fused, 5000);
+        if (result != MATRIX_ACCEL_SUCCESS) {
+            printf("ERROR: Fused attention (shift %lu) failed: %s\n",
+                   (unsigned long)shift, matrix_accel_error_string(result));
+            return false;
+        }
+        
+        for (int i = 0; i < MATRIX_SIZE; i++) {
+            for (int j = 0; j < MATRIX_SIZE; j++) {
+                int32_t expected = 0;
+                for (int n = 0; n < MATRIX_SIZE; n++) {
+                    expected += probs[t][i][n] * v[n][j];
+                }
+                if ((int32_t)fused[i][j] != expected) {
+                    printf("ERROR: Attention shift %lu [%d][%d] got %ld expected %ld\n",
+                           (unsigned long)shift, i, j,
+                           (long)(int32_t)fused[i][j], (long)expected);
+                    return false;
+                }
+            }
+        }
+    }
+    
+    // An all-zero query attends uniformly: each output is the column mean
+    for (int j = 0; j < MATRIX_SIZE; j++) {
+        int32_t sum = 0;
+        for (int i = 0; i < MATRIX_SIZE; i++) {
+            sum += v[i][j];
+        }
+        if ((int32_t)fused[2][j] != sum * (SOFTMAX_ONE / MATRIX_SIZE)) {
+            printf("ERROR: Uniform attention column %d got %ld expected %ld\n",
+                   j, (long)(int32_t)fused[2][j], (long)(sum * (SOFTMAX_ONE / MATRIX_SIZE)));
+            return false;
+        }
+    }
+    
+    return true;
+}